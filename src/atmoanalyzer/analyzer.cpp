@@ -9,14 +9,17 @@ namespace {
 
     using namespace atmo;
 
-    auto createDeviceChannels(Devices& devices) {
-        std::vector<std::vector<Color>> channels_per_device{};
-        channels_per_device.reserve(devices.size());
-        for (const auto& device : devices.devices()) {
-            auto& device_channels = channels_per_device.emplace_back();
-            device_channels.resize(device.channels);
+    constexpr std::chrono::milliseconds WAIT_TIMEOUT{100};
+
+    template<class Function>
+    void runStage(const char* stage, Function function) {
+        try {
+            function();
+        } catch (const std::exception& e) {
+            spdlog::error("Error in Ambilight analyzer {} stage: {}", stage, e.what());
+        } catch (...) {
+            spdlog::error("Unknown error in Ambilight analyzer {} stage", stage);
         }
-        return channels_per_device;
     }
 
 }
@@ -25,56 +28,104 @@ namespace atmo {
 
     Analyzer::Analyzer(std::unique_ptr<CaptureDevice> capture_device,
                        Devices& devices,
-                       Mappings mappings) :
+                       MappingTable mapping_table,
+                       double fps,
+                       const SmoothingConfig& smoothing) :
             m_interrupted{false},
             m_capture_device{std::move(capture_device)},
             m_devices{&devices},
-            m_mappings{std::move(mappings)},
-            m_channels_per_device{createDeviceChannels(devices)},
-            m_worker{[this]() { run(); }} {}
+            m_mapping_table{std::move(mapping_table)},
+            m_scheduler{fps},
+            m_smoother{smoothing},
+            m_captured_channels{},
+            m_device_channels{std::vector<Color>(m_mapping_table.outputs())},
+            m_capture_dropped{0},
+            m_analyzed_frames{0},
+            m_output_frames{0},
+            m_capture_worker{[this]() { runCapture(); }},
+            m_analysis_worker{[this]() { runAnalysis(); }},
+            m_output_worker{[this]() { runOutput(); }} {}
 
     Analyzer::~Analyzer() {
         m_interrupted = true;
-        if (m_worker.joinable()) {
-            m_worker.join();
+        m_captured_channels.interrupt();
+        m_device_channels.interrupt();
+        for (auto* worker : {&m_capture_worker, &m_analysis_worker, &m_output_worker}) {
+            if (worker->joinable()) {
+                worker->join();
+            }
         }
+
+        const auto statistics = this->statistics();
+        spdlog::info("Exiting Ambilight analyzer ({} frames captured, {} analyzed, {} submitted; "
+                     "{} capture, {} analysis and {} output frames dropped)",
+                     statistics.capture.frames, statistics.analysis.frames, statistics.output.frames,
+                     statistics.capture.dropped, statistics.analysis.dropped, statistics.output.dropped);
     }
 
-    void Analyzer::processFrame() {
-        const auto channels = m_capture_device->capture();
-        handleChannels(channels.top, m_mappings.top);
-        handleChannels(channels.bottom, m_mappings.bottom);
-        handleChannels(channels.left, m_mappings.left);
-        handleChannels(channels.right, m_mappings.right);
-        submitChannels();
+    AnalyzerStatistics Analyzer::statistics() const {
+        AnalyzerStatistics statistics{};
+        statistics.capture.frames = m_captured_channels.published();
+        statistics.capture.dropped = m_capture_dropped;
+        statistics.analysis.frames = m_analyzed_frames;
+        statistics.analysis.dropped = m_captured_channels.dropped();
+        statistics.analysis.queue_depth = m_captured_channels.depth();
+        statistics.output.frames = m_output_frames;
+        statistics.output.dropped = m_device_channels.dropped();
+        statistics.output.queue_depth = m_device_channels.depth();
+        return statistics;
     }
 
-    void Analyzer::handleChannels(const std::vector<Color>& capture_channels,
-                                  const std::vector<Mapping>& mappings) {
-        for (Channel i = 0; i < capture_channels.size(); ++i) {
-            const auto& mapping = mappings.at(i);
-            auto& device_channels = m_channels_per_device.at(mapping.device_index);
-            device_channels.at(mapping.device_channel) = capture_channels[i];
+    bool Analyzer::captureFrame() {
+        // The slots of the queue are recycled, so the capture device fills the channels of an earlier frame in place.
+        auto& channels = m_captured_channels.back();
+        if (!m_capture_device->capture(channels) || channels.empty()) {
+            return false;
         }
+        m_captured_channels.publish();
+        return true;
+    }
+
+    void Analyzer::analyzeFrame() {
+        auto& channels = m_captured_channels.front();
+        m_smoother.apply(channels.all(), Smoother::Clock::now());
+        m_mapping_table.apply(channels.all(), m_device_channels.back());
+        m_device_channels.publish();
+        ++m_analyzed_frames;
     }
 
-    void Analyzer::submitChannels() {
+    void Analyzer::submitFrame() {
+        const auto& device_channels = m_device_channels.front();
         for (DeviceIndex device = 0; device < m_devices->size(); ++device) {
-            m_devices->setChannels(device, m_channels_per_device[device]);
+            m_devices->submitChannels(device, m_mapping_table.deviceChannels(device_channels, device));
         }
+        ++m_output_frames;
     }
 
-    void Analyzer::run() {
+    void Analyzer::runCapture() {
+        m_scheduler.start(FrameScheduler::Clock::now());
         while (!m_interrupted) {
-            try {
-                processFrame();
-            } catch (const std::exception& e) {
-                spdlog::error("Error in Ambilight analyzer: {}", e.what());
-            } catch (...) {
-                spdlog::error("Unknown error in Ambilight analyzer");
+            bool captured{false};
+            runStage("capture", [this, &captured]() { captured = captureFrame(); });
+            m_scheduler.wait(captured);
+            m_capture_dropped = m_scheduler.statistics().dropped;
+        }
+    }
+
+    void Analyzer::runAnalysis() {
+        while (!m_interrupted) {
+            if (m_captured_channels.waitAndConsume(WAIT_TIMEOUT)) {
+                runStage("analysis", [this]() { analyzeFrame(); });
             }
         }
-        spdlog::info("Exiting Ambilight analyzer");
     }
 
-}
\ No newline at end of file
+    void Analyzer::runOutput() {
+        while (!m_interrupted) {
+            if (m_device_channels.waitAndConsume(WAIT_TIMEOUT)) {
+                runStage("output", [this]() { submitFrame(); });
+            }
+        }
+    }
+
+}
@@ -7,24 +7,82 @@
 #include <fmt/format.h>
 #include <spdlog/spdlog.h>
 
+#include <atmo/network_devices.hpp>
 #include <atmo/serial_devices.hpp>
 #include <atmo/spi_devices.hpp>
+#include <atmo/virtual_devices.hpp>
 #include <atmo/open_cv_capture.hpp>
+#include <atmo/v4l2_capture.hpp>
 #include <atmo/config.hpp>
 
 namespace {
 
     using namespace atmo;
 
+    template<class Type>
+    std::unique_ptr<AtmoDevice> configureAtmoDevice(std::unique_ptr<Type> atmo_device,
+                                                    const Configuration::Device& device) {
+        atmo_device->setUpdatePolicy(device.update_policy);
+        atmo_device->setColorCorrection(device.color_correction);
+        return atmo_device;
+    }
+
+#ifdef WITH_SPI
+    template<class Protocol>
+    std::unique_ptr<AtmoDevice> createSPIStrip(const Configuration::Device& device) {
+        return configureAtmoDevice(
+                std::make_unique<SPIStrip<Protocol>>(device.filename, device.channels, device.spi), device);
+    }
+
+    template<template<GlobalBrightness> class Protocol>
+    std::unique_ptr<AtmoDevice> createSPIStrip(const Configuration::Device& device) {
+        switch (device.global_brightness) {
+            case GlobalBrightness::Full:
+                return createSPIStrip<Protocol<GlobalBrightness::Full>>(device);
+            case GlobalBrightness::Color:
+                return createSPIStrip<Protocol<GlobalBrightness::Color>>(device);
+            default:
+                return createSPIStrip<Protocol<GlobalBrightness::HighDepth>>(device);
+        }
+    }
+#endif
+
     std::unique_ptr<AtmoDevice> createAtmoDevice(const Configuration::Device& device) {
         switch (device.type) {
             case DeviceType::AtmoLight:
-                return std::make_unique<AtmoLight>(device.filename);
+                return configureAtmoDevice(std::make_unique<AtmoLight>(device.filename, device.serial), device);
             case DeviceType::KarateLight:
-                return std::make_unique<KarateLight>(device.filename);
+                return configureAtmoDevice(std::make_unique<KarateLight>(device.filename, device.serial), device);
+            case DeviceType::DDP:
+                return configureAtmoDevice(std::make_unique<DDPDevice>(device.network, device.channels), device);
+            case DeviceType::E131:
+                return configureAtmoDevice(std::make_unique<E131Device>(device.network, device.channels), device);
+            case DeviceType::ArtNet:
+                return configureAtmoDevice(std::make_unique<ArtNetDevice>(device.network, device.channels), device);
+            case DeviceType::Null:
+                return configureAtmoDevice(std::make_unique<NullDevice>(device.channels, device.simulation), device);
+            case DeviceType::Memory:
+                return configureAtmoDevice(
+                        std::make_unique<MemoryDevice>(device.channels, device.capacity, device.simulation), device);
+            case DeviceType::File:
+                return configureAtmoDevice(std::make_unique<FileDevice>(
+                        device.filename, device.channels, FileType::Regular, device.simulation), device);
+            case DeviceType::Fifo:
+                return configureAtmoDevice(std::make_unique<FileDevice>(
+                        device.filename, device.channels, FileType::Fifo, device.simulation), device);
 #ifdef WITH_SPI
                 case DeviceType::DotStar:
-                    return std::make_unique<DotStar>(device.filename, device.channels);
+                    return createSPIStrip<DotStar::Protocol>(device);
+                case DeviceType::APA102:
+                    return createSPIStrip<APA102Protocol>(device);
+                case DeviceType::SK9822:
+                    return createSPIStrip<SK9822Protocol>(device);
+                case DeviceType::WS2801:
+                    return createSPIStrip<WS2801Protocol>(device);
+                case DeviceType::LPD8806:
+                    return createSPIStrip<LPD8806Protocol>(device);
+                case DeviceType::P9813:
+                    return createSPIStrip<P9813Protocol>(device);
 #endif
             default:
                 throw std::runtime_error{fmt::format(
@@ -58,6 +116,13 @@ namespace {
                 } else {
                     return std::make_unique<OpenCVCapture>(capture.filename, capture.channel_configs);
                 }
+#endif
+#ifdef WITH_V4L2
+            case CaptureType::V4L2:
+                return std::make_unique<V4L2Capture>(
+                        capture.filename,
+                        V4L2Capture::Format{capture.width, capture.height, capture.pixel_format},
+                        capture.channel_configs);
 #endif
             default:
                 throw std::runtime_error{fmt::format(
@@ -74,18 +139,33 @@ namespace {
         return std::make_unique<ControlServer>(devices,
                                                std::move(mode_callbacks),
                                                config.control()->address,
-                                               config.control()->port);
+                                               config.control()->port,
+                                               config.control()->push_interval,
+                                               config.control()->threads,
+                                               config.control()->request_threads);
+    }
+
+    std::optional<MappingTable> createMappingTable(const Configuration& config, const Devices& devices) {
+        if (!config.analyzer()) {
+            return {};
+        }
+        return MappingTable{config.analyzer()->mappings,
+                            config.analyzer()->capture.channel_configs,
+                            devices.devices()};
     }
 
     std::unique_ptr<Analyzer> createAnalyzer(const Configuration& config,
-                                             Devices& devices) {
+                                             Devices& devices,
+                                             const MappingTable& mapping_table) {
         if (!config.analyzer()) {
             return {};
         }
         auto capture_device = createCaptureDevice(config.analyzer()->capture);
         return std::make_unique<Analyzer>(std::move(capture_device),
                                           devices,
-                                          config.analyzer()->mappings);
+                                          mapping_table,
+                                          config.analyzer()->fps,
+                                          config.analyzer()->smoothing);
     }
 
 }
@@ -96,8 +176,10 @@ namespace atmo {
             m_mutex{},
             m_condition_variable{},
             m_interrupted{false},
+            m_mode_mutex{},
             m_configuration{config_file},
             m_devices{createDevices(m_configuration)},
+            m_mapping_table{createMappingTable(m_configuration, *m_devices)},
             m_control_server{createControlServer(
                     m_configuration,
                     *m_devices, {
@@ -133,6 +215,7 @@ namespace atmo {
     }
 
     Mode Application::getMode() const {
+        std::lock_guard<std::mutex> lock{m_mode_mutex};
         if (m_analyzer) {
             return Mode::Analyzer;
         }
@@ -140,6 +223,7 @@ namespace atmo {
     }
 
     void Application::setMode(Mode process_mode) {
+        std::lock_guard<std::mutex> lock{m_mode_mutex};
         switch (process_mode) {
             case Mode::Control:
                 spdlog::info("Switching to Control mode");
@@ -149,7 +233,7 @@ namespace atmo {
             case Mode::Analyzer:
                 if (m_configuration.analyzer()) {
                     spdlog::info("Switching to Analyzer mode");
-                    m_analyzer = createAnalyzer(m_configuration, *m_devices);
+                    m_analyzer = createAnalyzer(m_configuration, *m_devices, *m_mapping_table);
                 } else {
                     throw std::runtime_error{
                             "Analyzer mode cannot be activated, because the mode has not been configured"};
@@ -0,0 +1,482 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <atmo/border_analyzer.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <fmt/format.h>
+
+namespace {
+
+    using namespace atmo;
+
+    /**
+     * The byte offsets of the color components within one pixel of a packed RGB format.
+     */
+    struct PixelLayout {
+        std::size_t size;
+        std::size_t red;
+        std::size_t green;
+        std::size_t blue;
+    };
+
+    PixelLayout pixelLayout(PixelFormat format) {
+        switch (format) {
+            case PixelFormat::BGR:
+                return {3, 2, 1, 0};
+            case PixelFormat::RGB:
+                return {3, 0, 1, 2};
+            case PixelFormat::BGRA:
+                return {4, 2, 1, 0};
+            default:
+                throw std::runtime_error{fmt::format("Unsupported pixel format {}", format)};
+        }
+    }
+
+    bool isYuv(PixelFormat format) {
+        return format == PixelFormat::YUYV || format == PixelFormat::NV12;
+    }
+
+    /**
+     * The areas of one side, laid out along a strip of the image.
+     */
+    struct StripLayout {
+        float area_length;
+        int begin;
+        int end;
+    };
+
+    StripLayout stripLayout(const ChannelConfig& config, int offset, int length) {
+        const auto area_length = static_cast<float>(length) / config.count;
+        const auto last_area = static_cast<float>(config.count - 1);
+        return {area_length,
+                offset,
+                offset + static_cast<Width>(area_length * last_area) + static_cast<Width>(area_length)};
+    }
+
+    /**
+     * A range of pixels extended to full macro pixels of chroma subsampled formats.
+     */
+    struct ChromaRange {
+        int begin;
+        int end;
+        bool first_partial;
+        bool last_partial;
+    };
+
+    ChromaRange chromaRange(int begin, int end) {
+        return {begin & ~1, (end + 1) & ~1, (begin & 1) != 0, (end & 1) != 0};
+    }
+
+    void checkRange(int begin, int end, int limit, const char* dimension) {
+        if (begin < 0 || end < begin || end > limit) {
+            throw std::runtime_error{fmt::format("Area [{}, {}) exceeds the image {} of {} pixels",
+                                                 begin, end, dimension, limit)};
+        }
+    }
+
+    /**
+     * Append the sums of the color components of the pixels of one line to the prefix sums.
+     */
+    void appendPrefix(std::uint64_t* prefix, std::uint64_t first, std::uint64_t second, std::uint64_t third) {
+        prefix[3] = prefix[0] + first;
+        prefix[4] = prefix[1] + second;
+        prefix[5] = prefix[2] + third;
+    }
+
+    std::uint8_t clampComponent(int value) {
+        return static_cast<std::uint8_t>(std::clamp(value, 0, 255));
+    }
+
+    /**
+     * Convert limited range BT.601 YUV (as delivered by most capture devices) to RGB.
+     */
+    Color yuvToColor(int y, int u, int v) {
+        const auto c = y - 16;
+        const auto d = u - 128;
+        const auto e = v - 128;
+        return Color{clampComponent((298 * c + 409 * e + 128) >> 8),
+                     clampComponent((298 * c - 100 * d - 208 * e + 128) >> 8),
+                     clampComponent((298 * c + 516 * d + 128) >> 8)};
+    }
+
+    Color meanColor(PixelFormat format, const std::uint64_t* begin, const std::uint64_t* end, std::uint64_t pixels) {
+        if (pixels == 0) {
+            return Color{};
+        }
+        const auto first = static_cast<std::uint8_t>((end[0] - begin[0]) / pixels);
+        const auto second = static_cast<std::uint8_t>((end[1] - begin[1]) / pixels);
+        const auto third = static_cast<std::uint8_t>((end[2] - begin[2]) / pixels);
+        if (isYuv(format)) {
+            return yuvToColor(first, second, third);
+        }
+        return Color{first, second, third};
+    }
+
+    /**
+     * Return the sampling step along a strip. It is limited to the length of one area, so every area with at least
+     * one pixel contains a sample.
+     */
+    int stripStep(Width stride, const StripLayout& strip) {
+        return std::clamp(static_cast<int>(stride), 1, std::max(1, static_cast<int>(strip.area_length)));
+    }
+
+    /**
+     * Return the number of samples with the given step in the range [begin, begin + length) of a strip.
+     */
+    std::uint64_t sampleCount(int begin, int length, int step) {
+        return static_cast<std::uint64_t>((begin + length + step - 1) / step - (begin + step - 1) / step);
+    }
+
+    /**
+     * Sum up the given byte range of every step-th row of [y, y + depth) per column.
+     */
+    template<class Row>
+    void sumRows(const PixelKernels& kernels,
+                 Row row,
+                 int y,
+                 int depth,
+                 int step,
+                 std::size_t begin,
+                 std::size_t end,
+                 std::vector<std::uint32_t>& sums) {
+        sums.assign(end - begin, 0);
+        for (int current = y; current < y + depth; current += step) {
+            kernels.accumulate(row(current) + begin, end - begin, sums.data());
+        }
+    }
+
+    /**
+     * Add the color components of every step-th pixel of [begin, end) in row y to sums. The components are R, G, B
+     * for RGB formats and Y, U, V for YUV formats. If PerSample is set, every sample has its own three accumulators,
+     * otherwise all samples are added to the first three.
+     */
+    template<bool PerSample>
+    void sampleRow(const ImageView& image, int y, int begin, int end, int step, std::uint32_t* sums) {
+        const auto add = [&sums](std::uint32_t first, std::uint32_t second, std::uint32_t third) {
+            sums[0] += first;
+            sums[1] += second;
+            sums[2] += third;
+            if constexpr (PerSample) {
+                sums += 3;
+            }
+        };
+        const auto* row = image.row(y);
+        switch (image.format) {
+            case PixelFormat::YUYV:
+                for (int x = begin; x < end; x += step) {
+                    const auto* macro_pixel = row + (x & ~1) * 2;
+                    add(row[x * 2], macro_pixel[1], macro_pixel[3]);
+                }
+                break;
+            case PixelFormat::NV12: {
+                const auto* chroma = image.chromaRow(y);
+                for (int x = begin; x < end; x += step) {
+                    add(row[x], chroma[x & ~1], chroma[(x & ~1) + 1]);
+                }
+                break;
+            }
+            default: {
+                const auto layout = pixelLayout(image.format);
+                for (int x = begin; x < end; x += step) {
+                    const auto* pixel = row + x * layout.size;
+                    add(pixel[layout.red], pixel[layout.green], pixel[layout.blue]);
+                }
+                break;
+            }
+        }
+    }
+
+}
+
+namespace atmo {
+
+    BorderAnalyzer::BorderAnalyzer(ChannelConfigs channel_configs) :
+            m_channel_configs{channel_configs},
+            m_kernels{&pixelKernels()},
+            m_width{-1},
+            m_height{-1},
+            m_top{},
+            m_bottom{},
+            m_left{},
+            m_right{},
+            m_areas{},
+            m_line_sums{},
+            m_chroma_sums{},
+            m_prefix_sums{} {}
+
+    Channels BorderAnalyzer::analyze(const ImageView& image) {
+        Channels channels{};
+        analyze(image, channels);
+        return channels;
+    }
+
+    void BorderAnalyzer::analyze(const ImageView& image, Channels& channels) {
+        if (image.format == PixelFormat::NV12 && image.chroma == nullptr) {
+            throw std::runtime_error{"Missing chroma plane of NV12 image"};
+        }
+
+        updateGeometry(image.width, image.height);
+        channels.resize(m_top.area_count, m_bottom.area_count, m_left.area_count, m_right.area_count);
+        analyzeHorizontalStrip(image, m_top, channels.top());
+        analyzeHorizontalStrip(image, m_bottom, channels.bottom());
+        analyzeVerticalStrip(image, m_left, channels.left());
+        analyzeVerticalStrip(image, m_right, channels.right());
+    }
+
+    void BorderAnalyzer::updateGeometry(int width, int height) {
+        if (width == m_width && height == m_height) {
+            return;
+        }
+
+        const auto& configs = m_channel_configs;
+        const auto inner_width = width - configs.left.crop - configs.right.crop;
+        const auto inner_height = height - configs.top.crop - configs.bottom.crop;
+        m_areas.clear();
+        m_top = compileStrip(configs.top,
+                             configs.left.crop,
+                             inner_width,
+                             configs.top.crop,
+                             configs.top.stride_x,
+                             configs.top.stride_y);
+        m_bottom = compileStrip(configs.bottom,
+                                configs.left.crop,
+                                inner_width,
+                                height - configs.bottom.crop - configs.bottom.depth,
+                                configs.bottom.stride_x,
+                                configs.bottom.stride_y);
+        m_left = compileStrip(configs.left,
+                              configs.top.crop,
+                              inner_height,
+                              configs.left.crop,
+                              configs.left.stride_y,
+                              configs.left.stride_x);
+        m_right = compileStrip(configs.right,
+                               configs.top.crop,
+                               inner_height,
+                               width - configs.right.crop - configs.right.depth,
+                               configs.right.stride_y,
+                               configs.right.stride_x);
+
+        std::size_t length{0};
+        for (const auto* strip : {&m_top, &m_bottom, &m_left, &m_right}) {
+            if (strip->area_count == 0) {
+                continue;
+            }
+            const auto horizontal = strip == &m_top || strip == &m_bottom;
+            checkRange(strip->begin, strip->end, horizontal ? width : height, horizontal ? "width" : "height");
+            checkRange(strip->position,
+                       strip->position + strip->depth,
+                       horizontal ? height : width,
+                       horizontal ? "height" : "width");
+            length = std::max(length, static_cast<std::size_t>(strip->end - strip->begin));
+        }
+
+        // Reserve the buffers for the longest strip (including partial macro pixels at both ends), so they are never
+        // reallocated while analyzing frames.
+        m_line_sums.reserve((length + 2) * 4);
+        m_chroma_sums.reserve(length + 2);
+        m_prefix_sums.reserve((length + 1) * 3);
+        m_width = width;
+        m_height = height;
+    }
+
+    BorderAnalyzer::StripGeometry BorderAnalyzer::compileStrip(const ChannelConfig& config,
+                                                               int begin,
+                                                               int length,
+                                                               int position,
+                                                               Width stride_along,
+                                                               Width stride_across) {
+        StripGeometry strip{};
+        strip.first_area = m_areas.size();
+        strip.area_count = config.count;
+        if (config.count == 0) {
+            return strip;
+        }
+
+        const auto layout = stripLayout(config, begin, length);
+        strip.begin = layout.begin;
+        strip.end = layout.end;
+        strip.position = position;
+        strip.depth = config.depth;
+        strip.step_along = stripStep(stride_along, layout);
+        strip.step_across = std::max(1, static_cast<int>(stride_across));
+
+        const auto samples_across = sampleCount(0, strip.depth, strip.step_across);
+        for (Channel channel = 0; channel < config.count; ++channel) {
+            const int offset = static_cast<Width>(layout.area_length * channel);
+            const int area_length = static_cast<Width>(layout.area_length);
+            m_areas.push_back({static_cast<std::size_t>(offset),
+                               static_cast<std::size_t>(area_length),
+                               sampleCount(offset, area_length, strip.step_along) * samples_across});
+        }
+        return strip;
+    }
+
+    void BorderAnalyzer::analyzeHorizontalStrip(const ImageView& image,
+                                                const StripGeometry& strip,
+                                                gsl::span<Color> channels) {
+        if (strip.area_count == 0) {
+            return;
+        }
+
+        // Sum up the rows of the strip per column and build the prefix sums along the strip.
+        const auto y = strip.position;
+        const auto step_y = strip.step_across;
+        const auto length = static_cast<std::size_t>(strip.end - strip.begin);
+        const auto rows = [&image](int row) { return image.row(row); };
+        m_prefix_sums.assign((length + 1) * 3, 0);
+        if (strip.step_along > 1) {
+            sampleHorizontalStrip(image, strip);
+        } else {
+            switch (image.format) {
+                case PixelFormat::YUYV: {
+                    const auto range = chromaRange(strip.begin, strip.end);
+                    sumRows(*m_kernels, rows, y, strip.depth, step_y, range.begin * 2U, range.end * 2U, m_line_sums);
+                    for (std::size_t x = 0; x < length; ++x) {
+                        const auto pixel = static_cast<std::size_t>(strip.begin - range.begin) + x;
+                        const auto* macro_pixel = m_line_sums.data() + pixel / 2 * 4;
+                        appendPrefix(m_prefix_sums.data() + x * 3,
+                                     macro_pixel[pixel % 2 * 2], macro_pixel[1], macro_pixel[3]);
+                    }
+                    break;
+                }
+                case PixelFormat::NV12: {
+                    const auto range = chromaRange(strip.begin, strip.end);
+                    const auto chroma_rows = [&image](int row) { return image.chromaRow(row); };
+                    sumRows(*m_kernels, rows, y, strip.depth, step_y, strip.begin, strip.end, m_line_sums);
+                    sumRows(*m_kernels, chroma_rows, y, strip.depth, step_y, range.begin, range.end, m_chroma_sums);
+                    for (std::size_t x = 0; x < length; ++x) {
+                        const auto pixel = static_cast<std::size_t>(strip.begin - range.begin) + x;
+                        const auto* chroma = m_chroma_sums.data() + pixel / 2 * 2;
+                        appendPrefix(m_prefix_sums.data() + x * 3, m_line_sums[x], chroma[0], chroma[1]);
+                    }
+                    break;
+                }
+                default: {
+                    const auto layout = pixelLayout(image.format);
+                    sumRows(*m_kernels, rows, y, strip.depth, step_y,
+                            strip.begin * layout.size, strip.end * layout.size, m_line_sums);
+                    for (std::size_t x = 0; x < length; ++x) {
+                        const auto* column = m_line_sums.data() + x * layout.size;
+                        appendPrefix(m_prefix_sums.data() + x * 3,
+                                     column[layout.red], column[layout.green], column[layout.blue]);
+                    }
+                    break;
+                }
+            }
+        }
+
+        meanColors(image.format, strip, channels);
+    }
+
+    void BorderAnalyzer::sampleHorizontalStrip(const ImageView& image, const StripGeometry& strip) {
+        // Only every step_along-th column is sampled, the other columns do not contribute to the prefix sums.
+        const auto length = static_cast<std::size_t>(strip.end - strip.begin);
+        const auto step = static_cast<std::size_t>(strip.step_along);
+        m_line_sums.assign((length + step - 1) / step * 3, 0);
+        for (int row = strip.position; row < strip.position + strip.depth; row += strip.step_across) {
+            sampleRow<true>(image, row, strip.begin, strip.end, strip.step_along, m_line_sums.data());
+        }
+        for (std::size_t x = 0; x < length; ++x) {
+            const auto* column = m_line_sums.data() + x / step * 3;
+            if (x % step == 0) {
+                appendPrefix(m_prefix_sums.data() + x * 3, column[0], column[1], column[2]);
+            } else {
+                appendPrefix(m_prefix_sums.data() + x * 3, 0, 0, 0);
+            }
+        }
+    }
+
+    void BorderAnalyzer::analyzeVerticalStrip(const ImageView& image,
+                                              const StripGeometry& strip,
+                                              gsl::span<Color> channels) {
+        if (strip.area_count == 0) {
+            return;
+        }
+
+        // Sum up the columns of the strip per row and build the prefix sums along the strip. Rows that are not
+        // sampled do not contribute to the prefix sums.
+        const auto x = strip.position;
+        const auto length = static_cast<std::size_t>(strip.end - strip.begin);
+        const auto step_y = static_cast<std::size_t>(strip.step_along);
+        m_prefix_sums.assign((length + 1) * 3, 0);
+        if (strip.depth > 0) {
+            for (std::size_t y = 0; y < length; ++y) {
+                const auto row = strip.begin + static_cast<int>(y);
+                std::array<std::uint32_t, 3> sums{0, 0, 0};
+                if (y % step_y == 0) {
+                    if (strip.step_across > 1) {
+                        sampleRow<false>(image, row, x, x + strip.depth, strip.step_across, sums.data());
+                    } else {
+                        sums = sumRow(image, row, x, x + strip.depth);
+                    }
+                }
+                appendPrefix(m_prefix_sums.data() + y * 3, sums[0], sums[1], sums[2]);
+            }
+        }
+
+        meanColors(image.format, strip, channels);
+    }
+
+    void BorderAnalyzer::meanColors(PixelFormat format,
+                                    const StripGeometry& strip,
+                                    gsl::span<Color> channels) const {
+        for (std::size_t channel = 0; channel < strip.area_count; ++channel) {
+            const auto& area = m_areas[strip.first_area + channel];
+            const auto* prefix = m_prefix_sums.data() + area.offset * 3;
+            channels[static_cast<std::ptrdiff_t>(channel)] = meanColor(format, prefix, prefix + area.length * 3,
+                                                                       area.samples);
+        }
+    }
+
+    std::array<std::uint32_t, 3> BorderAnalyzer::sumRow(const ImageView& image, int y, int begin, int end) const {
+        switch (image.format) {
+            case PixelFormat::YUYV: {
+                // Sum up whole macro pixels and remove the pixels outside of the range afterwards.
+                const auto range = chromaRange(begin, end);
+                const auto* pixels = image.row(y);
+                std::uint32_t sums[4]{0, 0, 0, 0};
+                m_kernels->sumInterleaved(pixels + range.begin * 2, (range.end - range.begin) * 2U, 4, sums);
+                std::array<std::uint32_t, 3> yuv{sums[0] + sums[2], sums[1] * 2, sums[3] * 2};
+                if (range.first_partial) {
+                    const auto* first = pixels + range.begin * 2;
+                    yuv = {yuv[0] - first[0], yuv[1] - first[1], yuv[2] - first[3]};
+                }
+                if (range.last_partial) {
+                    const auto* last = pixels + (range.end - 2) * 2;
+                    yuv = {yuv[0] - last[2], yuv[1] - last[1], yuv[2] - last[3]};
+                }
+                return yuv;
+            }
+            case PixelFormat::NV12: {
+                const auto range = chromaRange(begin, end);
+                const auto* chroma = image.chromaRow(y);
+                std::uint32_t luma{0};
+                std::uint32_t sums[2]{0, 0};
+                m_kernels->sumInterleaved(image.row(y) + begin, end - begin, 1, &luma);
+                m_kernels->sumInterleaved(chroma + range.begin, range.end - range.begin, 2, sums);
+                std::array<std::uint32_t, 3> yuv{luma, sums[0] * 2, sums[1] * 2};
+                if (range.first_partial) {
+                    yuv = {yuv[0], yuv[1] - chroma[range.begin], yuv[2] - chroma[range.begin + 1]};
+                }
+                if (range.last_partial) {
+                    yuv = {yuv[0], yuv[1] - chroma[range.end - 2], yuv[2] - chroma[range.end - 1]};
+                }
+                return yuv;
+            }
+            default: {
+                const auto layout = pixelLayout(image.format);
+                std::uint32_t sums[4]{0, 0, 0, 0};
+                m_kernels->sumInterleaved(image.row(y) + begin * layout.size,
+                                          (end - begin) * layout.size,
+                                          layout.size,
+                                          sums);
+                return {sums[layout.red], sums[layout.green], sums[layout.blue]};
+            }
+        }
+    }
+
+}
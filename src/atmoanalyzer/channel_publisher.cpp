@@ -0,0 +1,270 @@
+//
+// Created by Benedikt on 17.10.2026.
+//
+
+#include "channel_publisher.hpp"
+
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+namespace {
+
+    using json = nlohmann::json;
+    using namespace atmo;
+
+    bool equal(const Color& a, const Color& b) {
+        return a.red == b.red && a.green == b.green && a.blue == b.blue;
+    }
+
+    void writeColor(json& color_node, const Color& color) {
+        color_node["red"] = color.red;
+        color_node["green"] = color.green;
+        color_node["blue"] = color.blue;
+    }
+
+    std::shared_ptr<const std::string> serializeChannels(DeviceIndex device, gsl::span<const Color> channels) {
+        json message{};
+        message["event"] = "channels";
+        message["device"] = device;
+        auto& channels_node = message["channels"];
+        channels_node = json::array();
+        for (const auto& color : channels) {
+            writeColor(channels_node.emplace_back(), color);
+        }
+        return std::make_shared<const std::string>(message.dump());
+    }
+
+    std::shared_ptr<const std::string> serializeDelta(DeviceIndex device,
+                                                      gsl::span<const Color> previous,
+                                                      gsl::span<const Color> channels) {
+        json message{};
+        message["event"] = "channel_delta";
+        message["device"] = device;
+        auto& channels_node = message["channels"];
+        channels_node = json::array();
+        for (std::ptrdiff_t channel = 0; channel < channels.size(); ++channel) {
+            if (channel < previous.size() && equal(previous[channel], channels[channel])) {
+                continue;
+            }
+            auto& channel_node = channels_node.emplace_back();
+            channel_node["channel"] = channel;
+            writeColor(channel_node, channels[channel]);
+        }
+        return std::make_shared<const std::string>(message.dump());
+    }
+
+}
+
+namespace atmo {
+
+    ChannelPublisher::ChannelPublisher(Devices& devices,
+                                       boost::asio::io_context& io_context,
+                                       std::chrono::milliseconds interval) :
+            m_devices{&devices},
+            m_interval{interval},
+            m_strand{boost::asio::make_strand(io_context)},
+            m_timer{m_strand},
+            m_mutex{},
+            m_subscriber_count{0},
+            m_latest(devices.size()),
+            m_tracked(devices.size(), false),
+            m_dirty(devices.size(), false),
+            m_subscribers{},
+            m_next_id{0},
+            m_scheduled{false},
+            m_last_publish{},
+            m_snapshots(devices.size()),
+            m_published(devices.size()),
+            m_changed(devices.size(), false),
+            m_receivers{} {
+        m_devices->setChannelsListener([this](DeviceIndex device, gsl::span<const Color> channels) {
+            onChannels(device, channels);
+        });
+    }
+
+    ChannelPublisher::~ChannelPublisher() {
+        m_devices->setChannelsListener({});
+    }
+
+    void ChannelPublisher::subscribe(const std::shared_ptr<Subscriber>& subscriber, Subscription subscription) {
+        for (const auto device : subscription.devices) {
+            if (device >= m_devices->size()) {
+                throw DeviceNotFound{device};
+            }
+        }
+
+        SubscriberEntry entry{0,
+                              subscriber.get(),
+                              subscriber,
+                              std::vector<bool>(m_devices->size(), subscription.devices.empty()),
+                              subscription.delta,
+                              std::vector<bool>(m_devices->size(), false)};
+        for (const auto device : subscription.devices) {
+            entry.devices[device] = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            entry.id = ++m_next_id;
+            const auto existing = std::find_if(std::begin(m_subscribers), std::end(m_subscribers),
+                                               [&entry](const auto& other) { return other.key == entry.key; });
+            if (existing != std::end(m_subscribers)) {
+                *existing = std::move(entry);
+            } else {
+                m_subscribers.push_back(std::move(entry));
+            }
+            updateSubscriberCount();
+            std::fill(std::begin(m_dirty), std::end(m_dirty), true);
+            schedule();
+        }
+        refresh();
+    }
+
+    void ChannelPublisher::unsubscribe(const Subscriber* subscriber) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_subscribers.erase(std::remove_if(std::begin(m_subscribers), std::end(m_subscribers),
+                                           [subscriber](const auto& entry) { return entry.key == subscriber; }),
+                            std::end(m_subscribers));
+        updateSubscriberCount();
+    }
+
+    void ChannelPublisher::onChannels(DeviceIndex device, gsl::span<const Color> channels) {
+        // Called for every written frame, so neither lock nor copy the colors while nobody is interested in them.
+        if (m_subscriber_count == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_latest[device].assign(std::begin(channels), std::end(channels));
+        m_tracked[device] = true;
+        m_dirty[device] = true;
+        if (!m_subscribers.empty()) {
+            schedule();
+        }
+    }
+
+    void ChannelPublisher::refresh() {
+        // The listener is called with the device locked, so the devices must not be queried while m_mutex is locked.
+        // Colors reported by the listener in the meantime are at least as new as the ones read here.
+        for (DeviceIndex device = 0; device < m_devices->size(); ++device) {
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                if (m_tracked[device] || m_subscribers.empty()) {
+                    continue;
+                }
+            }
+            auto channels = m_devices->getChannels(device);
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (!m_tracked[device] && !m_subscribers.empty()) {
+                m_latest[device] = std::move(channels);
+                m_tracked[device] = true;
+                m_dirty[device] = true;
+                schedule();
+            }
+        }
+    }
+
+    void ChannelPublisher::updateSubscriberCount() {
+        m_subscriber_count = m_subscribers.size();
+        if (m_subscribers.empty()) {
+            // Changes are not reported anymore, so the colors have to be read again for the next subscriber.
+            std::fill(std::begin(m_tracked), std::end(m_tracked), false);
+        }
+    }
+
+    void ChannelPublisher::schedule() {
+        if (m_scheduled) {
+            return;
+        }
+        m_scheduled = true;
+        // The timer is only accessed by the strand, while changes are reported by arbitrary threads.
+        boost::asio::post(m_strand, [this]() {
+            m_timer.expires_at(std::max(Clock::now(), m_last_publish + m_interval));
+            m_timer.async_wait([this](const boost::system::error_code& error) {
+                if (!error) {
+                    publish();
+                }
+            });
+        });
+    }
+
+    void ChannelPublisher::publish() {
+        // Take the changed colors and the subscribers under the lock, but serialize and push them without holding it.
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_scheduled = false;
+            m_last_publish = Clock::now();
+
+            m_subscribers.erase(std::remove_if(std::begin(m_subscribers), std::end(m_subscribers),
+                                               [](const auto& entry) { return entry.subscriber.expired(); }),
+                                std::end(m_subscribers));
+            updateSubscriberCount();
+
+            for (DeviceIndex device = 0; device < m_dirty.size(); ++device) {
+                // Untracked colors stay dirty until they have been read for the new subscribers.
+                m_changed[device] = m_dirty[device] && m_tracked[device];
+                if (m_changed[device]) {
+                    m_dirty[device] = false;
+                    m_snapshots[device].assign(std::begin(m_latest[device]), std::end(m_latest[device]));
+                }
+            }
+            m_receivers.assign(std::begin(m_subscribers), std::end(m_subscribers));
+        }
+
+        for (DeviceIndex device = 0; device < m_changed.size(); ++device) {
+            if (m_changed[device]) {
+                publish(device);
+            }
+        }
+
+        // Keep the synchronization state, unless the subscription has been replaced or cancelled in the meantime.
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for (auto& receiver : m_receivers) {
+            const auto entry = std::find_if(std::begin(m_subscribers), std::end(m_subscribers),
+                                            [&receiver](const auto& other) { return other.id == receiver.id; });
+            if (entry != std::end(m_subscribers)) {
+                entry->synchronized = std::move(receiver.synchronized);
+            }
+        }
+        m_receivers.clear();
+    }
+
+    void ChannelPublisher::publish(DeviceIndex device) {
+        auto& latest = m_snapshots[device];
+        auto& published = m_published[device];
+        const auto changed = !std::equal(std::begin(latest), std::end(latest),
+                                         std::begin(published), std::end(published), equal);
+
+        // Serialize lazily, but at most once per format.
+        std::shared_ptr<const std::string> channels_message{};
+        std::shared_ptr<const std::string> delta_message{};
+        for (auto& entry : m_receivers) {
+            if (!entry.devices[device]) {
+                continue;
+            }
+            const auto subscriber = entry.subscriber.lock();
+            if (!subscriber) {
+                continue;
+            }
+
+            if (entry.delta && entry.synchronized[device]) {
+                if (!changed) {
+                    continue;
+                }
+                if (!delta_message) {
+                    delta_message = serializeDelta(device, published, latest);
+                }
+                entry.synchronized[device] = subscriber->push(delta_message);
+            } else {
+                if (entry.synchronized[device] && !changed) {
+                    continue;
+                }
+                if (!channels_message) {
+                    channels_message = serializeChannels(device, latest);
+                }
+                entry.synchronized[device] = subscriber->push(channels_message);
+            }
+        }
+        published.swap(latest);
+    }
+
+}
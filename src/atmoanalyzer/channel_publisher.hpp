@@ -0,0 +1,156 @@
+//
+// Created by Benedikt on 17.10.2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <boost/asio.hpp>
+#include <atmo/devices.hpp>
+
+namespace atmo {
+
+    /**
+     * A receiver of pushed channel updates, e.g. a client connection.
+     */
+    class Subscriber {
+    public:
+        virtual ~Subscriber() = default;
+
+        /**
+         * Push a serialized message to the subscriber. The message is shared by all subscribers and must not be
+         * modified. This method is called by the publisher and must not block.
+         *
+         * @param message the serialized message
+         * @return false if the message has been dropped because the subscriber does not keep up
+         */
+        virtual bool push(std::shared_ptr<const std::string> message) = 0;
+    };
+
+    /**
+     * The channels a subscriber is interested in.
+     */
+    struct Subscription {
+        /**
+         * The indices of the devices to subscribe to or empty for all devices.
+         */
+        std::vector<DeviceIndex> devices{};
+
+        /**
+         * Push only the changed channels instead of all channels of a device. The first update of each device and the
+         * first update after a dropped message always contain all channels.
+         */
+        bool delta{false};
+    };
+
+    /**
+     * The ChannelPublisher pushes the channels of devices to subscribers whenever they change. Changes are coalesced:
+     * at most one update per device is pushed each interval, containing the newest colors. Each update is serialized
+     * once per format (all channels or delta) and the buffer is shared by all subscribers.
+     *
+     * The colors are only tracked while there are subscribers. Updates are serialized and pushed by the strand of the
+     * publisher without holding its mutex, so reporting changes never waits for the subscribers.
+     *
+     * Updates are pushed as JSON messages with an 'event' field instead of a 'msg_id':
+     *
+     *     {"event": "channels", "device": 0, "channels": [{"red": 255, "green": 0, "blue": 0}, ...]}
+     *     {"event": "channel_delta", "device": 0, "channels": [{"channel": 3, "red": 255, "green": 0, "blue": 0}, ...]}
+     */
+    class ChannelPublisher {
+    public:
+        /**
+         * Constructor. Registers the publisher as channels listener of the given devices.
+         *
+         * @param devices the devices to publish
+         * @param io_context the I/O context that runs the publisher
+         * @param interval the minimum interval between two updates of the same device
+         */
+        ChannelPublisher(Devices& devices, boost::asio::io_context& io_context, std::chrono::milliseconds interval);
+
+        /**
+         * Destructor. Removes the channels listener.
+         */
+        ~ChannelPublisher();
+
+        ChannelPublisher(const ChannelPublisher&) = delete;
+
+        ChannelPublisher& operator=(const ChannelPublisher&) = delete;
+
+        /**
+         * Subscribe to channel updates or replace the subscription of the given subscriber. The current colors of all
+         * subscribed devices are pushed with the next update.
+         *
+         * @param subscriber the subscriber, which is removed automatically once it has expired
+         * @param subscription the devices and format of the updates
+         */
+        void subscribe(const std::shared_ptr<Subscriber>& subscriber, Subscription subscription);
+
+        /**
+         * Cancel the subscription of the given subscriber.
+         *
+         * @param subscriber the subscriber
+         */
+        void unsubscribe(const Subscriber* subscriber);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct SubscriberEntry {
+            std::uint64_t id;
+            const Subscriber* key;
+            std::weak_ptr<Subscriber> subscriber;
+            std::vector<bool> devices;
+            bool delta;
+            std::vector<bool> synchronized;
+        };
+
+        Devices* m_devices;
+        std::chrono::milliseconds m_interval;
+        boost::asio::strand<boost::asio::io_context::executor_type> m_strand;
+        boost::asio::steady_timer m_timer;
+        std::mutex m_mutex;
+        std::atomic<std::size_t> m_subscriber_count;
+        std::vector<std::vector<Color>> m_latest;
+        std::vector<bool> m_tracked;
+        std::vector<bool> m_dirty;
+        std::vector<SubscriberEntry> m_subscribers;
+        std::uint64_t m_next_id;
+        bool m_scheduled;
+        Clock::time_point m_last_publish;
+
+        // Only accessed by the strand.
+        std::vector<std::vector<Color>> m_snapshots;
+        std::vector<std::vector<Color>> m_published;
+        std::vector<bool> m_changed;
+        std::vector<SubscriberEntry> m_receivers;
+
+        void onChannels(DeviceIndex device, gsl::span<const Color> channels);
+
+        /**
+         * Read the colors of all devices that have not been tracked while there were no subscribers. Must not be
+         * called with m_mutex locked.
+         */
+        void refresh();
+
+        /**
+         * Update the number of subscribers after m_subscribers has been changed. Requires m_mutex to be locked.
+         */
+        void updateSubscriberCount();
+
+        /**
+         * Schedule the next update unless it has already been scheduled. Requires m_mutex to be locked.
+         */
+        void schedule();
+
+        void publish();
+
+        void publish(DeviceIndex device);
+    };
+
+}
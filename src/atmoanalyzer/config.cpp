@@ -4,6 +4,8 @@
 
 #include <atmo/config.hpp>
 
+#include <chrono>
+#include <limits>
 #include <yaml-cpp/yaml.h>
 #include <fmt/format.h>
 
@@ -33,21 +35,55 @@ namespace {
         return node.as<Type>();
     }
 
+    template<class Type>
+    std::optional<Type> readOptional(const YAML::Node& parent, const std::string& node_name) {
+        const auto node = parent[node_name];
+        if (!node) {
+            return {};
+        }
+        return node.as<Type>();
+    }
+
     auto readRequiredCaptureType(const YAML::Node& parent, const std::string& node_name) {
         const auto type = readRequired<std::string>(parent, node_name);
         if (type == "opencv") {
             return CaptureType::OpenCV;
+        } else if (type == "v4l2") {
+            return CaptureType::V4L2;
         } else {
             throw std::runtime_error{fmt::format("Illegal capture type: '{}'", type)};
         }
     }
 
+    std::optional<PixelFormat> readOptionalPixelFormat(const YAML::Node& parent, const std::string& node_name) {
+        const auto pixel_format = readOptional<std::string>(parent, node_name);
+        if (!pixel_format) {
+            return {};
+        } else if (*pixel_format == "yuyv") {
+            return PixelFormat::YUYV;
+        } else if (*pixel_format == "nv12") {
+            return PixelFormat::NV12;
+        } else if (*pixel_format == "rgb") {
+            return PixelFormat::RGB;
+        } else if (*pixel_format == "bgr") {
+            return PixelFormat::BGR;
+        } else {
+            throw std::runtime_error{fmt::format("Illegal pixel format: '{}'", *pixel_format)};
+        }
+    }
+
     auto readChannelConfig(const YAML::Node& config_node) {
         ChannelConfig config{};
         if (config_node) {
             config.count = readOptional<Channel>(config_node, "count", 0);
             config.depth = readOptional<Width>(config_node, "depth", 20);
             config.crop = readOptional<Width>(config_node, "crop", 0);
+            config.stride_x = readOptional<Width>(config_node, "stride_x", 1);
+            config.stride_y = readOptional<Width>(config_node, "stride_y", 1);
+            if (config.stride_x == 0 || config.stride_y == 0) {
+                throw std::runtime_error{fmt::format("Illegal channel stride: {}x{}",
+                                                     config.stride_x, config.stride_y)};
+            }
         }
         return config;
     }
@@ -58,6 +94,9 @@ namespace {
         capture.type = readRequiredCaptureType(capture_node, "type");
         capture.filename = readOptional<std::string>(capture_node, "filename", "");
         capture.index = readOptional<int>(capture_node, "index", -1);
+        capture.width = readOptional<int>(capture_node, "width");
+        capture.height = readOptional<int>(capture_node, "height");
+        capture.pixel_format = readOptionalPixelFormat(capture_node, "pixel_format");
         capture.channel_configs.top = readChannelConfig(capture_node["top"]);
         capture.channel_configs.bottom = readChannelConfig(capture_node["bottom"]);
         capture.channel_configs.left = readChannelConfig(capture_node["left"]);
@@ -73,18 +112,182 @@ namespace {
             return DeviceType::KarateLight;
         } else if (type == "dotstar") {
             return DeviceType::DotStar;
+        } else if (type == "apa102") {
+            return DeviceType::APA102;
+        } else if (type == "sk9822") {
+            return DeviceType::SK9822;
+        } else if (type == "ws2801") {
+            return DeviceType::WS2801;
+        } else if (type == "lpd8806") {
+            return DeviceType::LPD8806;
+        } else if (type == "p9813") {
+            return DeviceType::P9813;
+        } else if (type == "ddp") {
+            return DeviceType::DDP;
+        } else if (type == "e131") {
+            return DeviceType::E131;
+        } else if (type == "artnet") {
+            return DeviceType::ArtNet;
+        } else if (type == "null") {
+            return DeviceType::Null;
+        } else if (type == "memory") {
+            return DeviceType::Memory;
+        } else if (type == "file") {
+            return DeviceType::File;
+        } else if (type == "fifo") {
+            return DeviceType::Fifo;
         } else {
             throw std::runtime_error{fmt::format("Illegal device type: '{}'", type)};
         }
     }
 
+    auto readColorCorrection(const YAML::Node& color_correction_node) {
+        ColorCorrection color_correction{};
+        if (!color_correction_node) {
+            return color_correction;
+        }
+        color_correction.gamma = readOptional(color_correction_node, "gamma", color_correction.gamma);
+        color_correction.brightness = readOptional(color_correction_node, "brightness", color_correction.brightness);
+        color_correction.red = readOptional(color_correction_node, "red", color_correction.red);
+        color_correction.green = readOptional(color_correction_node, "green", color_correction.green);
+        color_correction.blue = readOptional(color_correction_node, "blue", color_correction.blue);
+        const auto min_threshold = readOptional<unsigned int>(color_correction_node, "min_threshold", 0);
+        if (min_threshold > std::numeric_limits<std::uint8_t>::max()) {
+            throw std::runtime_error{fmt::format("Illegal color correction min_threshold: {}", min_threshold)};
+        }
+        color_correction.min_threshold = static_cast<std::uint8_t>(min_threshold);
+        return color_correction;
+    }
+
+    auto readSerialConfig(const YAML::Node& serial_node) {
+        using boost::asio::serial_port_base;
+        SerialConfig serial{};
+        if (!serial_node) {
+            return serial;
+        }
+        serial.baud_rate = readOptional<unsigned int>(serial_node, "baud_rate");
+        serial.character_size = readOptional(serial_node, "character_size", serial.character_size);
+        if (serial.character_size < 5 || serial.character_size > 8) {
+            throw std::runtime_error{fmt::format("Illegal serial character size: {}", serial.character_size)};
+        }
+
+        const auto parity = readOptional<std::string>(serial_node, "parity", "none");
+        if (parity == "none") {
+            serial.parity = serial_port_base::parity::none;
+        } else if (parity == "odd") {
+            serial.parity = serial_port_base::parity::odd;
+        } else if (parity == "even") {
+            serial.parity = serial_port_base::parity::even;
+        } else {
+            throw std::runtime_error{fmt::format("Illegal serial parity: '{}'", parity)};
+        }
+
+        const auto stop_bits = readOptional<std::string>(serial_node, "stop_bits", "1");
+        if (stop_bits == "1") {
+            serial.stop_bits = serial_port_base::stop_bits::one;
+        } else if (stop_bits == "1.5") {
+            serial.stop_bits = serial_port_base::stop_bits::onepointfive;
+        } else if (stop_bits == "2") {
+            serial.stop_bits = serial_port_base::stop_bits::two;
+        } else {
+            throw std::runtime_error{fmt::format("Illegal serial stop bits: '{}'", stop_bits)};
+        }
+
+        const auto flow_control = readOptional<std::string>(serial_node, "flow_control", "none");
+        if (flow_control == "none") {
+            serial.flow_control = serial_port_base::flow_control::none;
+        } else if (flow_control == "software") {
+            serial.flow_control = serial_port_base::flow_control::software;
+        } else if (flow_control == "hardware") {
+            serial.flow_control = serial_port_base::flow_control::hardware;
+        } else {
+            throw std::runtime_error{fmt::format("Illegal serial flow control: '{}'", flow_control)};
+        }
+        return serial;
+    }
+
+    auto readSPIConfig(const YAML::Node& spi_node) {
+        SPIConfig spi{};
+        if (!spi_node) {
+            return spi;
+        }
+        spi.speed = readOptional(spi_node, "speed", spi.speed);
+        const auto mode = readOptional<unsigned int>(spi_node, "mode", spi.mode);
+        if (mode > 3) {
+            throw std::runtime_error{fmt::format("Illegal SPI mode: {}", mode)};
+        }
+        spi.mode = static_cast<std::uint8_t>(mode);
+        spi.max_transfer_size = readOptional(spi_node, "max_transfer_size", spi.max_transfer_size);
+        spi.max_message_size = readOptional(spi_node, "max_message_size", spi.max_message_size);
+        return spi;
+    }
+
+    bool isNetworkDevice(DeviceType type) {
+        return type == DeviceType::DDP || type == DeviceType::E131 || type == DeviceType::ArtNet;
+    }
+
+    auto readNetworkConfig(const YAML::Node& device_node) {
+        NetworkConfig network{};
+        network.address = readRequired<std::string>(device_node, "address");
+        network.port = readOptional<std::uint16_t>(device_node, "port", 0);
+        network.universe = readOptional<std::uint16_t>(device_node, "universe");
+        network.sync = readOptional(device_node, "sync", false);
+        network.sync_universe = readOptional<std::uint16_t>(device_node, "sync_universe");
+        return network;
+    }
+
+    auto readSimulationConfig(const YAML::Node& simulation_node) {
+        SimulationConfig simulation{};
+        if (!simulation_node) {
+            return simulation;
+        }
+        simulation.write_latency = std::chrono::microseconds{
+                readOptional<unsigned int>(simulation_node, "write_latency_us", 0)};
+        simulation.failure_rate = readOptional(simulation_node, "failure_rate", simulation.failure_rate);
+        if (!(simulation.failure_rate >= 0.0 && simulation.failure_rate <= 1.0)) {
+            throw std::runtime_error{fmt::format("Illegal failure rate: {}", simulation.failure_rate)};
+        }
+        return simulation;
+    }
+
+    auto readOptionalGlobalBrightness(const YAML::Node& parent, const std::string& node_name) {
+        const auto global_brightness = readOptional<std::string>(parent, node_name, "high_depth");
+        if (global_brightness == "full") {
+            return GlobalBrightness::Full;
+        } else if (global_brightness == "color") {
+            return GlobalBrightness::Color;
+        } else if (global_brightness == "high_depth") {
+            return GlobalBrightness::HighDepth;
+        } else {
+            throw std::runtime_error{fmt::format("Illegal global brightness: '{}'", global_brightness)};
+        }
+    }
+
     auto readDevice(const YAML::Node& device_node) {
         Configuration::Device device{};
         device.name = readRequired<std::string>(device_node, "name");
         device.type = readRequiredDeviceType(device_node, "type");
-        device.filename = readRequired<std::string>(device_node, "filename");
+        if (isNetworkDevice(device.type)) {
+            device.network = readNetworkConfig(device_node);
+        } else if (device.type != DeviceType::Null && device.type != DeviceType::Memory) {
+            device.filename = readRequired<std::string>(device_node, "filename");
+        }
         device.channels = readOptional<Channel>(device_node, "channels", 0);
         device.reset_on_error = readOptional(device_node, "reset_on_error", false);
+        device.update_policy.skip_unchanged = readOptional(device_node, "skip_unchanged", true);
+        const auto tolerance = readOptional<unsigned int>(device_node, "change_tolerance", 0);
+        if (tolerance > std::numeric_limits<unsigned char>::max()) {
+            throw std::runtime_error{fmt::format("Illegal change tolerance: {}", tolerance)};
+        }
+        device.update_policy.tolerance = static_cast<unsigned char>(tolerance);
+        device.update_policy.keep_alive = std::chrono::milliseconds{
+                readOptional<unsigned int>(device_node, "keep_alive_ms", 1000)};
+        device.color_correction = readColorCorrection(device_node["color_correction"]);
+        device.serial = readSerialConfig(device_node["serial"]);
+        device.spi = readSPIConfig(device_node["spi"]);
+        device.global_brightness = readOptionalGlobalBrightness(device_node, "global_brightness");
+        device.capacity = readOptional<std::size_t>(device_node, "capacity", device.capacity);
+        device.simulation = readSimulationConfig(device_node["simulation"]);
         return device;
     }
 
@@ -105,6 +308,10 @@ namespace {
         Configuration::Control control{};
         control.address = readRequired<std::string>(control_node, "address");
         control.port = readRequired<std::uint16_t>(control_node, "port");
+        control.push_interval = std::chrono::milliseconds{
+                readOptional<unsigned int>(control_node, "push_interval_ms", 33)};
+        control.threads = readOptional<std::size_t>(control_node, "threads", 2);
+        control.request_threads = readOptional<std::size_t>(control_node, "request_threads", 4);
         return std::optional<Configuration::Control>{control};
     }
 
@@ -133,6 +340,21 @@ namespace {
         return mappings;
     }
 
+    auto readSmoothingConfig(const YAML::Node& smoothing_node) {
+        SmoothingConfig smoothing{};
+        if (!smoothing_node) {
+            return smoothing;
+        }
+        smoothing.time_constant = std::chrono::milliseconds{
+                readOptional<unsigned int>(smoothing_node, "time_constant_ms", 0)};
+        const auto scene_cut_threshold = readOptional<unsigned int>(smoothing_node, "scene_cut_threshold", 0);
+        if (scene_cut_threshold > std::numeric_limits<std::uint8_t>::max()) {
+            throw std::runtime_error{fmt::format("Illegal scene cut threshold: {}", scene_cut_threshold)};
+        }
+        smoothing.scene_cut_threshold = static_cast<std::uint8_t>(scene_cut_threshold);
+        return smoothing;
+    }
+
     auto readAnalyzerConfig(const YAML::Node& parent) {
         const auto analyzer_node = parent["analyzer"];
         if (!analyzer_node) {
@@ -141,6 +363,11 @@ namespace {
         Configuration::Analyzer analyzer{};
         analyzer.capture = readCaptureConfig(analyzer_node);
         analyzer.mappings = readAllMappings(analyzer_node);
+        analyzer.fps = readOptional<double>(analyzer_node, "fps", 0.0);
+        if (analyzer.fps < 0.0) {
+            throw std::runtime_error{fmt::format("Illegal analyzer frame rate: {}", analyzer.fps)};
+        }
+        analyzer.smoothing = readSmoothingConfig(analyzer_node["smoothing"]);
         return std::optional<Configuration::Analyzer>{analyzer};
     }
 
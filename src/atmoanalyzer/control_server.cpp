@@ -8,21 +8,64 @@
 #include <boost/beast/websocket.hpp>
 #include <boost/asio/dispatch.hpp>
 #include <boost/asio/strand.hpp>
+#include <fmt/format.h>
 #include <spdlog/spdlog.h>
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <optional>
+#include "channel_publisher.hpp"
 #include "request_handler.hpp"
 
+namespace {
+
+    /**
+     * The maximum number of pushed updates waiting to be written to a connection. Further updates are dropped until the
+     * client catches up.
+     */
+    constexpr std::size_t MAX_PENDING_PUSHES{4};
+
+    /**
+     * The maximum number of requests of a connection that have been read but not yet answered. Reading pauses until the
+     * client has read the responses.
+     */
+    constexpr std::size_t MAX_PENDING_REQUESTS{16};
+
+}
+
 namespace atmo {
 
     using namespace boost::asio::ip;
     namespace beast = boost::beast;
 
-    class Connection : public std::enable_shared_from_this<Connection> {
+    class Connection : public std::enable_shared_from_this<Connection>, public Subscriber {
     public:
-        Connection(RequestHandler& request_handler, tcp::socket&& socket) :
+        Connection(RequestHandler& request_handler, boost::asio::thread_pool& request_pool, tcp::socket&& socket) :
                 m_request_handler{&request_handler},
+                m_request_pool{&request_pool},
                 m_stream{std::move(socket)},
-                m_buffer{} {}
+                m_buffer{},
+                m_requests{},
+                m_pending_requests{0},
+                m_reading{false},
+                m_handling{false},
+                m_write_queue{},
+                m_writing{false},
+                m_pending_pushes{0},
+                m_closed{false} {}
+
+        bool push(std::shared_ptr<const std::string> message) override {
+            if (m_closed || m_pending_pushes >= MAX_PENDING_PUSHES) {
+                return false;
+            }
+            ++m_pending_pushes;
+            // Pushes are called by the publisher, while the stream may only be accessed by the connection's strand.
+            boost::asio::post(m_stream.get_executor(),
+                              [self = shared_from_this(), message = std::move(message)]() mutable {
+                                  self->write(std::move(message), false);
+                              });
+            return true;
+        }
 
         void accept(const boost::system::error_code& error) {
             m_endpoint = m_stream.next_layer().socket().remote_endpoint();
@@ -38,6 +81,9 @@ namespace atmo {
                          m_endpoint.address().to_string(),
                          m_endpoint.port());
 
+            // Pipelined responses are written back to back, which Nagle's algorithm would delay until acknowledged.
+            m_stream.next_layer().socket().set_option(tcp::no_delay{true});
+
             boost::asio::dispatch(m_stream.get_executor(),
                                   beast::bind_front_handler(
                                           &Connection::start,
@@ -45,6 +91,16 @@ namespace atmo {
         }
 
     private:
+        struct PendingRequest {
+            bool text;
+            std::string data;
+        };
+
+        struct PendingWrite {
+            std::shared_ptr<const std::string> message;
+            bool response;
+        };
+
         void start() {
             m_stream.set_option(
                     beast::websocket::stream_base::timeout::suggested(
@@ -64,13 +120,11 @@ namespace atmo {
 
         void run(const beast::error_code& error = {}) {
             if (error) {
-                spdlog::info("Connection from {}:{} has been closed: {}",
-                             m_endpoint.address().to_string(),
-                             m_endpoint.port(),
-                             error.message());
+                close(error);
                 return;
             }
 
+            m_reading = true;
             m_stream.async_read(m_buffer,
                                 beast::bind_front_handler(
                                         &Connection::readRequest,
@@ -78,73 +132,196 @@ namespace atmo {
         }
 
         void readRequest(const boost::system::error_code& error, std::size_t) {
+            m_reading = false;
             if (error) {
-                spdlog::info("Connection from {}:{} has been closed: {}",
-                             m_endpoint.address().to_string(),
-                             m_endpoint.port(),
-                             error.message());
+                close(error);
                 return;
             }
 
-            if (!m_stream.got_text()) {
-                spdlog::warn("Received binary data from client {}:{} instead of JSON ",
-                             m_endpoint.address().to_string(),
-                             m_endpoint.port());
+            m_requests.push_back(PendingRequest{m_stream.got_text(), beast::buffers_to_string(m_buffer.cdata())});
+            m_buffer.consume(m_buffer.size());
+            ++m_pending_requests;
+            if (!m_handling) {
+                handleNext();
+            }
+
+            // Read the next request while this one is handled, so clients can pipeline their requests.
+            if (m_pending_requests < MAX_PENDING_REQUESTS) {
+                run();
+            }
+        }
+
+        /**
+         * Requests may block on slow devices, so they are handled by the request pool instead of the I/O threads. The
+         * requests of a connection are handled one at a time, so they are executed and answered in order.
+         */
+        void handleNext() {
+            m_handling = true;
+            boost::asio::post(*m_request_pool,
+                              [self = shared_from_this(), request = std::move(m_requests.front())]() {
+                                  self->handleRequest(request);
+                              });
+            m_requests.pop_front();
+        }
+
+        void handleRequest(const PendingRequest& request) {
+            std::optional<std::string> response{};
+            if (request.text) {
+                response = m_request_handler->handleRequest(request.data, shared_from_this());
+            } else {
+                response = m_request_handler->handleBinaryRequest(
+                        {reinterpret_cast<const unsigned char*>(request.data.data()),
+                         static_cast<std::ptrdiff_t>(request.data.size())});
+            }
+
+            boost::asio::post(m_stream.get_executor(),
+                              [self = shared_from_this(), response = std::move(response)]() mutable {
+                                  self->requestHandled(std::move(response));
+                              });
+        }
+
+        void requestHandled(std::optional<std::string> response) {
+            m_handling = false;
+            if (!m_requests.empty() && !m_closed) {
+                handleNext();
+            }
+
+            if (!response) {
+                // Successful binary requests and requests without acknowledgement are not answered.
+                requestCompleted();
                 return;
             }
+            write(std::make_shared<const std::string>(std::move(*response)), true);
+        }
+
+        void requestCompleted() {
+            --m_pending_requests;
+            if (!m_reading && !m_closed && m_pending_requests < MAX_PENDING_REQUESTS) {
+                run();
+            }
+        }
 
-            const auto response = m_request_handler->handleRequest(beast::buffers_to_string(m_buffer.cdata()));
-            m_buffer.consume(m_buffer.cdata().size());
-            boost::asio::buffer_copy(m_buffer.prepare(response.size()), boost::asio::buffer(response));
-            m_buffer.commit(response.size());
+        /**
+         * Queue a message, since responses and pushed updates must not be written concurrently.
+         */
+        void write(std::shared_ptr<const std::string> message, bool response) {
+            if (m_closed) {
+                return;
+            }
+            m_write_queue.push_back(PendingWrite{std::move(message), response});
+            if (!m_writing) {
+                writeNext();
+            }
+        }
 
-            m_stream.async_write(m_buffer.cdata(),
+        void writeNext() {
+            m_writing = true;
+            m_stream.text(true);
+            m_stream.async_write(boost::asio::buffer(*m_write_queue.front().message),
                                  beast::bind_front_handler(
-                                         &Connection::responseWritten,
+                                         &Connection::messageWritten,
                                          shared_from_this()));
         }
 
-        void responseWritten(const boost::system::error_code& error, std::size_t) {
+        void messageWritten(const boost::system::error_code& error, std::size_t) {
+            const auto written = std::move(m_write_queue.front());
+            m_write_queue.pop_front();
+            m_writing = false;
+            if (!written.response) {
+                --m_pending_pushes;
+            }
+
             if (error) {
-                spdlog::info("Connection from {}:{} has been closed: {}",
-                             m_endpoint.address().to_string(),
-                             m_endpoint.port(),
-                             error.message());
+                close(error);
+                return;
+            }
+            if (m_closed) {
                 return;
             }
 
-            m_buffer.consume(m_buffer.size());
+            if (!m_write_queue.empty()) {
+                writeNext();
+            }
+            if (written.response) {
+                requestCompleted();
+            }
+        }
 
-            run();
+        void close(const boost::system::error_code& error) {
+            if (m_closed.exchange(true)) {
+                return;
+            }
+            spdlog::info("Connection from {}:{} has been closed: {}",
+                         m_endpoint.address().to_string(),
+                         m_endpoint.port(),
+                         error.message());
         }
 
         RequestHandler* m_request_handler;
+        boost::asio::thread_pool* m_request_pool;
         beast::websocket::stream<beast::tcp_stream> m_stream;
         tcp::endpoint m_endpoint;
         beast::flat_buffer m_buffer;
+        std::deque<PendingRequest> m_requests;
+        std::size_t m_pending_requests;
+        bool m_reading;
+        bool m_handling;
+        std::deque<PendingWrite> m_write_queue;
+        bool m_writing;
+        std::atomic<std::size_t> m_pending_pushes;
+        std::atomic<bool> m_closed;
     };
 
     ControlServer::ControlServer(Devices& devices,
                                  ModeCallbacks mode_callbacks,
                                  const std::string& host,
-                                 uint16_t port) :
-            m_request_handler{std::make_unique<RequestHandler>(devices, std::move(mode_callbacks))},
-            m_io_context{1},
+                                 uint16_t port,
+                                 std::chrono::milliseconds push_interval,
+                                 std::size_t threads,
+                                 std::size_t request_threads) :
+            m_io_context{static_cast<int>(threads)},
+            m_request_pool{request_threads},
+            m_publisher{std::make_unique<ChannelPublisher>(devices, m_io_context, push_interval)},
+            m_request_handler{std::make_unique<RequestHandler>(devices, std::move(mode_callbacks), m_publisher.get())},
             m_acceptor{m_io_context, tcp::endpoint{make_address(host), port}},
-            m_worker{[this] { runWorker(); }} {}
+            m_workers{} {
+        if (threads == 0 || request_threads == 0) {
+            throw std::runtime_error{fmt::format("Illegal number of control server threads: {} I/O and {} request "
+                                                 "threads", threads, request_threads)};
+        }
+
+        spdlog::info("Listening on {}:{} with {} I/O and {} request threads",
+                     m_acceptor.local_endpoint().address().to_string(),
+                     m_acceptor.local_endpoint().port(),
+                     threads,
+                     request_threads);
+        startAccept();
+        m_workers.reserve(threads);
+        for (std::size_t thread = 0; thread < threads; ++thread) {
+            m_workers.emplace_back([this] { runWorker(); });
+        }
+    }
 
     ControlServer::~ControlServer() {
         m_io_context.stop();
-        if (m_worker.joinable()) {
-            m_worker.join();
+        for (auto& worker : m_workers) {
+            worker.join();
         }
+        // Drop queued requests and wait for the running ones, which still access the request handler.
+        m_request_pool.stop();
+        m_request_pool.join();
+    }
+
+    std::uint16_t ControlServer::port() const {
+        return m_acceptor.local_endpoint().port();
     }
 
     void ControlServer::startAccept() {
         m_acceptor.async_accept(
                 boost::asio::make_strand(m_io_context),
                 [this](auto error, auto socket) {
-                    auto connection = std::make_shared<Connection>(*m_request_handler, std::move(socket));
+                    auto connection = std::make_shared<Connection>(*m_request_handler, m_request_pool,
+                                                                   std::move(socket));
                     connection->accept(error);
                     startAccept();
                 });
@@ -152,12 +329,7 @@ namespace atmo {
 
     void ControlServer::runWorker() {
         try {
-            spdlog::info("Listening on {}:{}",
-                         m_acceptor.local_endpoint().address().to_string(),
-                         m_acceptor.local_endpoint().port());
-            startAccept();
             m_io_context.run();
-            spdlog::info("Control server shutdown");
         } catch (std::exception& e) {
             spdlog::error("Error on command server worker thread: {}", e.what());
         }
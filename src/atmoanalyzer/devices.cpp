@@ -4,7 +4,10 @@
 
 #include <atmo/devices.hpp>
 
+#include <atomic>
+#include <condition_variable>
 #include <thread>
+#include <type_traits>
 #include <spdlog/spdlog.h>
 
 namespace {
@@ -21,87 +24,369 @@ namespace {
         }
     }
 
-    template<class Method, class... Args>
-    auto executeWithRetry(Device& device, Method method, Args&& ... args) {
-        uint8_t retry{0};
-        while (true) {
-            try {
-                return std::invoke(method, *device.device, std::forward<Args>(args)...);
-            } catch (const DeviceNotFound&) {
-                // Do not retry on illegal device index.
-                throw;
-            } catch (const std::exception& e) {
-                if (!device.reset_on_error) {
-                    spdlog::error("Device '{}' failed: {}", device.name, e.what());
-                    throw;
-                }
+    // Invalid arguments are rejected before the device is locked, they must not trigger a reset of the device.
+
+    void checkChannel(const Device& device, Channel channel) {
+        if (channel >= device.device->channels()) {
+            throw std::out_of_range{fmt::format("Invalid channel index: {}", channel)};
+        }
+    }
+
+    void checkChannels(const Device& device, gsl::span<const Color> channels) {
+        const auto available = device.device->channels();
+        if (static_cast<std::size_t>(channels.size()) > available) {
+            throw std::out_of_range{
+                    fmt::format("Invalid number of channels: {} available but {} given", available, channels.size())};
+        }
+    }
+}
+
+namespace atmo {
+
+    /**
+     * The ChannelsNotifier holds the ChannelsListener of a Devices manager. Replacing the listener waits for running
+     * notifications, so a removed listener is never called afterwards.
+     */
+    class ChannelsNotifier {
+    public:
+        ChannelsNotifier() :
+                m_mutex{},
+                m_listener{},
+                m_active{false} {}
+
+        void setListener(ChannelsListener listener) {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_listener = std::move(listener);
+            m_active = static_cast<bool>(m_listener);
+        }
+
+        /**
+         * Return whether a listener is set, so callers can skip collecting the colors otherwise.
+         */
+        [[nodiscard]]
+        bool active() const {
+            return m_active;
+        }
+
+        void notify(DeviceIndex device, gsl::span<const Color> channels) {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if (m_listener) {
+                m_listener(device, channels);
+            }
+        }
 
-                if (retry >= MAX_RETRIES) {
-                    spdlog::error("Giving up on device '{}' error: {}", device.name, e.what());
+    private:
+        std::mutex m_mutex;
+        ChannelsListener m_listener;
+        std::atomic<bool> m_active;
+    };
+
+    /**
+     * A DeviceWorker owns one Device and serializes all access to it. Synchronous calls are executed directly by the
+     * calling thread. Submitted colors are put into a single slot mailbox and written by a background writer thread.
+     *
+     * The writer holds the device mutex from taking the colors out of the mailbox until they have been written, so
+     * clear() can reliably drop pending colors. Retries of failed calls and writes wait without holding the device
+     * mutex, so a failing device does not block other callers during the backoff. The writer always retries with the
+     * newest submitted colors.
+     */
+    class DeviceWorker {
+    public:
+        DeviceWorker(Device device, DeviceIndex index, ChannelsNotifier& notifier) :
+                m_device{std::move(device)},
+                m_index{index},
+                m_notifier{&notifier},
+                m_device_mutex{},
+                m_mailbox_mutex{},
+                m_condition_variable{},
+                m_mailbox(m_device.device->channels()),
+                m_frame(m_device.device->channels()),
+                m_pending{false},
+                m_generation{0},
+                m_interrupted{false},
+                m_writer{[this]() { runWriter(); }} {}
+
+        ~DeviceWorker() {
+            {
+                std::lock_guard<std::mutex> lock{m_mailbox_mutex};
+                m_interrupted = true;
+            }
+            m_condition_variable.notify_all();
+            m_writer.join();
+        }
+
+        DeviceWorker(const DeviceWorker&) = delete;
+
+        DeviceWorker& operator=(const DeviceWorker&) = delete;
+
+        [[nodiscard]]
+        const Device& device() const {
+            return m_device;
+        }
+
+        template<class Method, class... Args>
+        auto execute(Method method, Args&& ... args) {
+            std::unique_lock<std::mutex> lock{m_device_mutex};
+            return executeWithRetry(lock, method, std::forward<Args>(args)...);
+        }
+
+        /**
+         * Execute a method that changes the channels and notify the listener about the new colors.
+         */
+        template<class Method, class... Args>
+        void modify(Method method, Args&& ... args) {
+            std::unique_lock<std::mutex> lock{m_device_mutex};
+            executeWithRetry(lock, method, std::forward<Args>(args)...);
+            notifyChannels();
+        }
+
+        void submit(gsl::span<const Color> channels) {
+            if (channels.size() > static_cast<std::ptrdiff_t>(m_mailbox.size())) {
+                throw std::out_of_range{
+                        fmt::format("Invalid number of channels: {} available but {} given",
+                                    m_mailbox.size(), channels.size())};
+            }
+            {
+                std::lock_guard<std::mutex> lock{m_mailbox_mutex};
+                std::copy(std::begin(channels), std::end(channels), std::begin(m_mailbox));
+                m_pending = true;
+            }
+            m_condition_variable.notify_all();
+        }
+
+        void clear() {
+            std::unique_lock<std::mutex> lock{m_device_mutex};
+            {
+                std::lock_guard<std::mutex> mailbox_lock{m_mailbox_mutex};
+                m_pending = false;
+                ++m_generation;
+            }
+            executeWithRetry(lock, &AtmoDevice::clear);
+            notifyChannels();
+        }
+
+    private:
+        Device m_device;
+        DeviceIndex m_index;
+        ChannelsNotifier* m_notifier;
+        std::mutex m_device_mutex;
+        std::mutex m_mailbox_mutex;
+        std::condition_variable m_condition_variable;
+        std::vector<Color> m_mailbox;
+        std::vector<Color> m_frame;
+        bool m_pending;
+        std::uint64_t m_generation;
+        bool m_interrupted;
+        std::thread m_writer;
+
+        /**
+         * Wait until colors have been submitted or, if retry is set, until the retry is due. Return false if the worker
+         * has been interrupted.
+         */
+        bool wait(bool retry, std::chrono::seconds retry_time) {
+            std::unique_lock<std::mutex> lock{m_mailbox_mutex};
+            if (retry) {
+                m_condition_variable.wait_for(lock, retry_time, [this]() { return m_interrupted; });
+            } else {
+                m_condition_variable.wait(lock, [this]() { return m_interrupted || m_pending; });
+            }
+            return !m_interrupted;
+        }
+
+        /**
+         * Execute a method of the device and retry it after resetting the device if it fails and the device is reset on
+         * errors. The device mutex is released while waiting for a retry.
+         */
+        template<class Method, class... Args>
+        std::invoke_result_t<Method, AtmoDevice&, Args&...> executeWithRetry(std::unique_lock<std::mutex>& lock,
+                                                                             Method method,
+                                                                             Args&& ... args) {
+            std::uint8_t retry{0};
+            while (true) {
+                try {
+                    return std::invoke(method, *m_device.device, args...);
+                } catch (const DeviceNotFound&) {
+                    // Do not retry on illegal device index.
                     throw;
-                }
+                } catch (const std::exception& e) {
+                    if (!m_device.reset_on_error) {
+                        spdlog::error("Device '{}' failed: {}", m_device.name, e.what());
+                        throw;
+                    }
+
+                    if (retry >= MAX_RETRIES) {
+                        spdlog::error("Giving up on device '{}' error: {}", m_device.name, e.what());
+                        throw;
+                    }
 
-                std::chrono::seconds wait_time{1U << retry};
-                spdlog::warn("Device '{}' failed: {}. Resetting device and retrying in {} seconds...",
-                             device.name, e.what(), wait_time.count());
-                std::this_thread::sleep_for(wait_time);
+                    std::chrono::seconds wait_time{1U << retry};
+                    spdlog::warn("Device '{}' failed: {}. Resetting device and retrying in {} seconds...",
+                                 m_device.name, e.what(), wait_time.count());
+                    lock.unlock();
+                    const auto interrupted = !wait(true, wait_time);
+                    lock.lock();
+                    if (interrupted) {
+                        throw;
+                    }
 
-                reset(device);
+                    reset(m_device);
 
-                ++retry;
+                    ++retry;
+                }
             }
         }
-    }
-}
 
-namespace atmo {
+        /**
+         * Notify the listener about the current colors of the device. Requires the device mutex to be locked.
+         */
+        void notifyChannels() {
+            if (m_notifier->active()) {
+                const auto channels = m_device.device->getChannels();
+                m_notifier->notify(m_index, channels);
+            }
+        }
+
+        /**
+         * Move the newest submitted colors to m_frame. If there are none, keep the current colors if they have not
+         * been dropped by clear(). Return false if there is nothing to write.
+         */
+        bool takeFrame(bool retry, std::uint64_t& generation) {
+            std::lock_guard<std::mutex> lock{m_mailbox_mutex};
+            if (m_pending) {
+                m_mailbox.swap(m_frame);
+                m_pending = false;
+                generation = m_generation;
+                return true;
+            }
+            return retry && generation == m_generation;
+        }
+
+        void runWriter() {
+            std::uint8_t retry{0};
+            std::uint64_t generation{0};
+            bool failed{false};
+            while (wait(retry > 0, std::chrono::seconds{1U << (retry > 0 ? retry - 1 : 0)})) {
+                std::lock_guard<std::mutex> lock{m_device_mutex};
+                if (retry > 0) {
+                    reset(m_device);
+                }
+                if (!takeFrame(retry > 0, generation)) {
+                    retry = 0;
+                    continue;
+                }
+
+                try {
+                    m_device.device->setChannels(m_frame);
+                    m_notifier->notify(m_index, m_frame);
+                    if (failed) {
+                        spdlog::info("Device '{}' recovered", m_device.name);
+                    }
+                    failed = false;
+                    retry = 0;
+                } catch (const std::exception& e) {
+                    if (!m_device.reset_on_error) {
+                        // Colors are usually submitted at the frame rate, so only report the first error.
+                        if (!failed) {
+                            spdlog::error("Device '{}' failed: {}", m_device.name, e.what());
+                        }
+                        failed = true;
+                    } else if (retry >= MAX_RETRIES) {
+                        spdlog::error("Giving up on device '{}' error: {}", m_device.name, e.what());
+                        failed = true;
+                        retry = 0;
+                    } else {
+                        spdlog::warn("Device '{}' failed: {}. Resetting device and retrying in {} seconds...",
+                                     m_device.name, e.what(), 1U << retry);
+                        failed = true;
+                        ++retry;
+                    }
+                }
+            }
+        }
+    };
 
     Devices::Devices(std::vector<Device> devices) :
-            m_mutex{},
-            m_devices{std::move(devices)} {}
+            m_notifier{std::make_unique<ChannelsNotifier>()},
+            m_devices{} {
+        m_devices.reserve(devices.size());
+        for (auto& device : devices) {
+            m_devices.push_back(std::make_unique<DeviceWorker>(std::move(device), m_devices.size(), *m_notifier));
+        }
+    }
+
+    Devices::~Devices() = default;
 
     std::vector<DeviceInfo> Devices::devices() const {
         std::vector<DeviceInfo> devices{};
         devices.reserve(m_devices.size());
         for (const auto& device : m_devices) {
-            devices.emplace_back(device.name, device.device->channels());
+            devices.emplace_back(device->device().name, device->device().device->channels());
         }
         return devices;
     }
 
     void Devices::clear() {
         for (auto& device : m_devices) {
-            executeWithRetry(device, &AtmoDevice::clear);
+            device->clear();
         }
     }
 
     Color Devices::getChannel(DeviceIndex device, Channel channel) {
-        std::lock_guard<std::mutex> lock{m_mutex};
-        return executeWithRetry(getDevice(device), &AtmoDevice::getChannel, channel);
+        auto& worker = getDevice(device);
+        checkChannel(worker.device(), channel);
+        return worker.execute(&AtmoDevice::getChannel, channel);
     }
 
     std::vector<Color> Devices::getChannels(DeviceIndex device) {
-        std::lock_guard<std::mutex> lock{m_mutex};
-        return executeWithRetry(getDevice(device), &AtmoDevice::getChannels);
+        return getDevice(device).execute(&AtmoDevice::getChannels);
     }
 
     void Devices::setChannel(DeviceIndex device, Channel channel, Color color) {
-        std::lock_guard<std::mutex> lock{m_mutex};
-        executeWithRetry(getDevice(device), &AtmoDevice::setChannel, channel, color);
+        auto& worker = getDevice(device);
+        checkChannel(worker.device(), channel);
+        worker.modify(&AtmoDevice::setChannel, channel, color);
     }
 
     void Devices::setChannels(DeviceIndex device, gsl::span<const Color> channels) {
-        std::lock_guard<std::mutex> lock{m_mutex};
-        executeWithRetry(getDevice(device), &AtmoDevice::setChannels, channels);
+        auto& worker = getDevice(device);
+        checkChannels(worker.device(), channels);
+        worker.modify(&AtmoDevice::setChannels, channels);
+    }
+
+    void Devices::setChannels(DeviceIndex device, Channel first, gsl::span<const Color> channels) {
+        auto& worker = getDevice(device);
+        const auto available = worker.device().device->channels();
+        if (first > available || static_cast<std::size_t>(channels.size()) > available - first) {
+            throw std::out_of_range{
+                    fmt::format("Invalid channel range: {} channels available but {} given starting at {}",
+                                available, channels.size(), first)};
+        }
+        worker.modify(&AtmoDevice::setChannelRange, first, channels);
     }
 
-    Device& Devices::getDevice(DeviceIndex device) {
+    void Devices::setChannelColors(DeviceIndex device, gsl::span<const ChannelColor> channel_colors) {
+        auto& worker = getDevice(device);
+        for (const auto& channel_color : channel_colors) {
+            checkChannel(worker.device(), channel_color.channel);
+        }
+        worker.modify(&AtmoDevice::setChannelColors, channel_colors);
+    }
+
+    void Devices::submitChannels(DeviceIndex device, gsl::span<const Color> channels) {
+        getDevice(device).submit(channels);
+    }
+
+    void Devices::setChannelsListener(ChannelsListener listener) {
+        m_notifier->setListener(std::move(listener));
+    }
+
+    DeviceWorker& Devices::getDevice(DeviceIndex device) {
         if (device >= m_devices.size()) {
             throw DeviceNotFound{device};
         }
-        return m_devices[device];
+        return *m_devices[device];
     }
 
     DeviceNotFound::DeviceNotFound(DeviceIndex device) :
             std::runtime_error{fmt::format("Invalid device index: {}", device)} {}
-}
\ No newline at end of file
+}
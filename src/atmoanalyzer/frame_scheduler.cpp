@@ -0,0 +1,68 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <atmo/frame_scheduler.hpp>
+
+#include <stdexcept>
+#include <thread>
+#include <fmt/format.h>
+
+namespace {
+
+    using namespace atmo;
+
+    auto frameInterval(double fps) {
+        if (fps < 0.0) {
+            throw std::runtime_error{fmt::format("Illegal frame rate: {}", fps)};
+        }
+        if (fps == 0.0) {
+            return FrameScheduler::Clock::duration::zero();
+        }
+        return std::chrono::duration_cast<FrameScheduler::Clock::duration>(std::chrono::duration<double>{1.0 / fps});
+    }
+
+}
+
+namespace atmo {
+
+    FrameScheduler::FrameScheduler(double fps) :
+            m_interval{frameInterval(fps)},
+            m_deadline{},
+            m_statistics{} {}
+
+    void FrameScheduler::start(Clock::time_point now) {
+        m_deadline = now;
+    }
+
+    FrameScheduler::Clock::time_point FrameScheduler::next(Clock::time_point now, bool captured) {
+        if (captured) {
+            ++m_statistics.frames;
+        } else {
+            ++m_statistics.empty;
+        }
+
+        if (!paced()) {
+            m_deadline = captured ? now : now + IDLE_INTERVAL;
+            return m_deadline;
+        }
+
+        m_deadline += m_interval;
+        if (now > m_deadline) {
+            // Skip all frame slots that have already passed completely, but keep the phase of the schedule.
+            const auto missed = (now - m_deadline) / m_interval;
+            m_statistics.dropped += missed;
+            m_deadline += missed * m_interval;
+        }
+        return m_deadline;
+    }
+
+    void FrameScheduler::wait(bool captured) {
+        const auto now = Clock::now();
+        const auto deadline = next(now, captured);
+        if (deadline > now) {
+            std::this_thread::sleep_until(deadline);
+        }
+    }
+
+}
@@ -10,13 +10,55 @@
 #include <thread>
 #include "capture_device.hpp"
 #include "devices.hpp"
+#include "frame_scheduler.hpp"
+#include "latest_queue.hpp"
+#include "mapping_table.hpp"
+#include "smoother.hpp"
 
 namespace atmo {
 
+    /**
+     * Counters of one stage of the Analyzer pipeline.
+     */
+    struct StageStatistics {
+        /**
+         * The number of frames processed by the stage.
+         */
+        std::uint64_t frames{0};
+
+        /**
+         * The number of frames the stage has dropped. For the capture stage these are missed frame slots, for all
+         * other stages these are frames in the input queue that have been replaced by a newer frame.
+         */
+        std::uint64_t dropped{0};
+
+        /**
+         * The number of frames currently waiting in the input queue of the stage.
+         */
+        std::size_t queue_depth{0};
+    };
+
+    /**
+     * Counters of all stages of the Analyzer pipeline.
+     */
+    struct AnalyzerStatistics {
+        StageStatistics capture;
+        StageStatistics analysis;
+        StageStatistics output;
+    };
+
     /**
      * The Analyzer processes the color input from a CaptureDevice and maps these input channels to the output channels
-     * of one or more output devices. Processing is done in a background thread and starts once the class has been
-     * constructed.
+     * of one or more output devices. Processing starts once the class has been constructed.
+     *
+     * Processing is split into a pipeline of three stages, each running in its own background thread:
+     * - capture:  Capture a frame and compute the input channels, paced to the target frame rate.
+     * - analysis: Smooth the input channels over time and map them to the channels of the output devices.
+     * - output:   Submit the channels to the writers of the output devices, without waiting for the devices.
+     *
+     * The stages are connected by queues that only keep the newest frame, so a slow output device does not stall the
+     * capture and the output devices always show the freshest frame. The queue slots serve as a pool of frames that
+     * are filled in place, so the pipeline does not allocate memory per frame.
      */
     class Analyzer {
     public:
@@ -25,30 +67,58 @@ namespace atmo {
          *
          * @param capture_device the capture device
          * @param devices the devices manager
-         * @param mappings the mappings from input channels to devices and output channels
+         * @param mapping_table the compiled mappings from input channels to devices and output channels
+         * @param fps the target frame rate or 0 to process frames as fast as the capture device delivers them
+         * @param smoothing the temporal smoothing configuration
          */
         Analyzer(std::unique_ptr<CaptureDevice> capture_device,
                  Devices& devices,
-                 Mappings mappings);
+                 MappingTable mapping_table,
+                 double fps,
+                 const SmoothingConfig& smoothing = {});
 
         ~Analyzer();
 
+        /**
+         * Return the current counters of all pipeline stages. This method is thread-safe.
+         *
+         * @return the pipeline statistics
+         */
+        [[nodiscard]]
+        AnalyzerStatistics statistics() const;
+
     private:
+        /**
+         * The channels of all devices in one contiguous buffer, see MappingTable.
+         */
+        using DeviceChannels = std::vector<Color>;
+
         std::atomic<bool> m_interrupted;
         std::unique_ptr<CaptureDevice> m_capture_device;
         Devices* m_devices;
-        Mappings m_mappings;
-        std::vector<std::vector<Color>> m_channels_per_device;
-        std::thread m_worker;
+        MappingTable m_mapping_table;
+        FrameScheduler m_scheduler;
+        Smoother m_smoother;
+        LatestQueue<Channels> m_captured_channels;
+        LatestQueue<DeviceChannels> m_device_channels;
+        std::atomic<std::uint64_t> m_capture_dropped;
+        std::atomic<std::uint64_t> m_analyzed_frames;
+        std::atomic<std::uint64_t> m_output_frames;
+        std::thread m_capture_worker;
+        std::thread m_analysis_worker;
+        std::thread m_output_worker;
+
+        bool captureFrame();
+
+        void analyzeFrame();
 
-        void handleChannels(const std::vector<Color>& capture_channels,
-                            const std::vector<Mapping>& mappings);
+        void submitFrame();
 
-        void submitChannels();
+        void runCapture();
 
-        void processFrame();
+        void runAnalysis();
 
-        void run();
+        void runOutput();
     };
 
 }
@@ -9,6 +9,7 @@
 #include <vector>
 #include <variant>
 #include <memory>
+#include <optional>
 #include <atmo/config.hpp>
 #include <atmo/analyzer.hpp>
 #include <atmo/devices.hpp>
@@ -45,8 +46,11 @@ namespace atmo {
         std::mutex m_mutex;
         std::condition_variable m_condition_variable;
         bool m_interrupted;
+        // Guards the mode, which is changed by concurrent control server requests.
+        mutable std::mutex m_mode_mutex;
         Configuration m_configuration;
         std::unique_ptr<Devices> m_devices;
+        std::optional<MappingTable> m_mapping_table;
         std::unique_ptr<ControlServer> m_control_server;
         std::unique_ptr<Analyzer> m_analyzer;
 
@@ -0,0 +1,148 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "image.hpp"
+#include "pixel_kernels.hpp"
+#include "types.hpp"
+
+namespace atmo {
+
+    /**
+     * The BorderAnalyzer calculates the mean colors of all configured screen areas of an image. It is independent of
+     * the capture backend and can be used by any CaptureDevice implementation.
+     *
+     * Instead of averaging every area separately, the four border strips (top, bottom, left and right) are read once
+     * each. Per strip, the pixels are summed up across the depth of the strip and a prefix sum is built along the
+     * strip, so the mean color of every area is computed in constant time, regardless of the number of areas. The
+     * results are identical to averaging each area individually (e.g. with cv::mean).
+     *
+     * The pixels are summed up with the fastest PixelKernels supported by the CPU. YUV images are averaged per
+     * component and the mean is converted to RGB.
+     *
+     * With ChannelConfig::stride_x and ChannelConfig::stride_y, only a regular grid of pixels is sampled per strip.
+     * Rows that are skipped are not read at all, which reduces the memory bandwidth for high resolution images.
+     *
+     * The ChannelConfigs are compiled into a table of strip and area descriptors once per image resolution. All buffers
+     * are reused, so analyzing frames of a constant resolution into the same Channels does not allocate memory.
+     */
+    class BorderAnalyzer {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param channel_configs the channel mapping configuration to use for creating the output channels
+         */
+        explicit BorderAnalyzer(ChannelConfigs channel_configs);
+
+        /**
+         * Calculate the colors of all channels for the given image.
+         *
+         * @param image the captured image
+         * @return the output color channels according to the channel configuration
+         */
+        [[nodiscard]]
+        Channels analyze(const ImageView& image);
+
+        /**
+         * Calculate the colors of all channels for the given image and store them in the given channels. The existing
+         * storage of the channels is reused.
+         *
+         * @param image the captured image
+         * @param channels the output color channels according to the channel configuration
+         */
+        void analyze(const ImageView& image, Channels& channels);
+
+    private:
+        /**
+         * The precomputed geometry of one area.
+         */
+        struct AreaGeometry {
+            /**
+             * The offset of the first pixel relative to the beginning of the strip.
+             */
+            std::size_t offset;
+
+            /**
+             * The length in pixels along the strip.
+             */
+            std::size_t length;
+
+            /**
+             * The number of sampled pixels.
+             */
+            std::uint64_t samples;
+        };
+
+        /**
+         * The precomputed geometry of the strip of one side.
+         */
+        struct StripGeometry {
+            /**
+             * The range of pixels along the strip (columns for horizontal strips, rows for vertical strips).
+             */
+            int begin{0};
+            int end{0};
+
+            /**
+             * The first row (horizontal strips) or column (vertical strips) of the strip.
+             */
+            int position{0};
+
+            /**
+             * The depth of the strip in pixels.
+             */
+            int depth{0};
+
+            /**
+             * The sampling steps along and across the strip.
+             */
+            int step_along{1};
+            int step_across{1};
+
+            /**
+             * The areas of the strip in m_areas.
+             */
+            std::size_t first_area{0};
+            std::size_t area_count{0};
+        };
+
+        ChannelConfigs m_channel_configs;
+        const PixelKernels* m_kernels;
+        int m_width;
+        int m_height;
+        StripGeometry m_top;
+        StripGeometry m_bottom;
+        StripGeometry m_left;
+        StripGeometry m_right;
+        std::vector<AreaGeometry> m_areas;
+        std::vector<std::uint32_t> m_line_sums;
+        std::vector<std::uint32_t> m_chroma_sums;
+        std::vector<std::uint64_t> m_prefix_sums;
+
+        void updateGeometry(int width, int height);
+
+        StripGeometry compileStrip(const ChannelConfig& config,
+                                   int begin,
+                                   int length,
+                                   int position,
+                                   Width stride_along,
+                                   Width stride_across);
+
+        void analyzeHorizontalStrip(const ImageView& image, const StripGeometry& strip, gsl::span<Color> channels);
+
+        void sampleHorizontalStrip(const ImageView& image, const StripGeometry& strip);
+
+        void analyzeVerticalStrip(const ImageView& image, const StripGeometry& strip, gsl::span<Color> channels);
+
+        void meanColors(PixelFormat format, const StripGeometry& strip, gsl::span<Color> channels) const;
+
+        std::array<std::uint32_t, 3> sumRow(const ImageView& image, int y, int begin, int end) const;
+    };
+
+}
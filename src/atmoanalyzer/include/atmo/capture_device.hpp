@@ -21,10 +21,14 @@ namespace atmo {
          * Capture and process one frame of input information. The output of this method has to match to the
          * configuration given by the user. This call may block until input data is available.
          *
-         * @return the output color channels according to a user provided configuration
+         * The channels are filled in place, so implementations should reuse their storage (see Channels::resize()) to
+         * keep the frame path free of allocations.
+         *
+         * @param channels the output color channels according to a user provided configuration
+         * @return true if a frame has been captured, false if no input data was available
          */
         [[nodiscard]]
-        virtual Channels capture() = 0;
+        virtual bool capture(Channels& channels) = 0;
     };
 
 }
\ No newline at end of file
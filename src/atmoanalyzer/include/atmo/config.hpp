@@ -8,6 +8,14 @@
 #include <optional>
 #include <vector>
 #include "types.hpp"
+#include <atmo/device.hpp>
+#include <atmo/network_devices.hpp>
+#include <atmo/serial_devices.hpp>
+#include <atmo/spi_devices.hpp>
+#include <atmo/spi_strip_packets.hpp>
+#include <atmo/virtual_devices.hpp>
+#include "image.hpp"
+#include "smoother.hpp"
 
 namespace atmo {
 
@@ -35,6 +43,11 @@ namespace atmo {
              */
             std::string filename{};
 
+            /**
+             * The receiver of network devices (ddp, e131, artnet), which are configured by address instead of filename.
+             */
+            NetworkConfig network{};
+
             /**
              * The number of channels supported by the device. This option is only supported by some devices (e.g.
              * devices with a variable amount of available lights), but then it is usually mandatory.
@@ -45,6 +58,41 @@ namespace atmo {
              * Try to reset the device on errors.
              */
             bool reset_on_error{false};
+
+            /**
+             * Controls when unchanged colors are written to the device.
+             */
+            UpdatePolicy update_policy{};
+
+            /**
+             * Gamma, white point and brightness correction of the colors written to the device.
+             */
+            ColorCorrection color_correction{};
+
+            /**
+             * The serial port configuration. This option is only supported by serial devices (e.g. atmolight).
+             */
+            SerialConfig serial{};
+
+            /**
+             * The SPI interface configuration. This option is only supported by SPI devices (e.g. dotstar).
+             */
+            SPIConfig spi{};
+
+            /**
+             * The global brightness strategy of APA102 and SK9822 strips.
+             */
+            GlobalBrightness global_brightness{GlobalBrightness::HighDepth};
+
+            /**
+             * The number of frames recorded by memory devices.
+             */
+            std::size_t capacity{100};
+
+            /**
+             * The simulated write latency and failures of virtual devices (null, memory, file, fifo).
+             */
+            SimulationConfig simulation{};
         };
 
         /**
@@ -60,6 +108,21 @@ namespace atmo {
              * The port to listen on (e.g. 22222)
              */
             std::uint16_t port;
+
+            /**
+             * The minimum interval between two channel updates pushed to subscribed connections.
+             */
+            std::chrono::milliseconds push_interval{33};
+
+            /**
+             * The number of threads serving the websockets.
+             */
+            std::size_t threads{2};
+
+            /**
+             * The number of threads handling requests, which may block on slow devices.
+             */
+            std::size_t request_threads{4};
         };
 
         /**
@@ -81,6 +144,21 @@ namespace atmo {
              */
             int index{-1};
 
+            /**
+             * The requested frame width in pixels (V4L2 only). Defaults to the current setting of the device.
+             */
+            std::optional<int> width{};
+
+            /**
+             * The requested frame height in pixels (V4L2 only). Defaults to the current setting of the device.
+             */
+            std::optional<int> height{};
+
+            /**
+             * The requested pixel format (V4L2 only). Defaults to YUYV or NV12, whichever is supported.
+             */
+            std::optional<PixelFormat> pixel_format{};
+
             /**
              * The channel mapping configuration.
              */
@@ -93,6 +171,17 @@ namespace atmo {
         struct Analyzer {
             Capture capture;
             Mappings mappings;
+
+            /**
+             * The target frame rate in frames per second. If 0, frames are processed as fast as the capture device
+             * delivers them.
+             */
+            double fps{0.0};
+
+            /**
+             * The temporal smoothing of the analyzed channels.
+             */
+            SmoothingConfig smoothing{};
         };
 
         /**
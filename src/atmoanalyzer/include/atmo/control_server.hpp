@@ -5,8 +5,10 @@
 #pragma once
 
 #include <boost/asio.hpp>
+#include <chrono>
 #include <functional>
 #include <thread>
+#include <vector>
 #include <gsl/span>
 #include "types.hpp"
 #include "devices.hpp"
@@ -14,13 +16,19 @@
 
 namespace atmo {
 
+    class ChannelPublisher;
+
     class RequestHandler;
 
     /**
      * The ControlServer allows to individually control output channels. If an analyzer has been configured, the
      * analyzer can also be started and stopped.
      *
-     * Currently the ControlServer uses JSON for request and response messages over websockets.
+     * Currently the ControlServer uses JSON for request and response messages over websockets. Connections can
+     * subscribe to channel updates, which are pushed to them whenever the channels change.
+     *
+     * The websockets are served by a pool of I/O threads, while requests are handled by a separate pool, so requests
+     * blocking on a slow device do not delay other connections.
      */
     class ControlServer {
     public:
@@ -31,19 +39,35 @@ namespace atmo {
          * @param mode_callbacks a struct containing
          * @param host
          * @param port
+         * @param push_interval the minimum interval between two channel updates pushed to subscribers
+         * @param threads the number of threads serving the websockets
+         * @param request_threads the number of threads handling requests
          */
         ControlServer(Devices& devices,
                       ModeCallbacks mode_callbacks,
                       const std::string& host,
-                      uint16_t port);
+                      uint16_t port,
+                      std::chrono::milliseconds push_interval,
+                      std::size_t threads,
+                      std::size_t request_threads);
 
         ~ControlServer();
 
+        /**
+         * Return the port the server is listening on, e.g. if it has been started with port 0.
+         *
+         * @return the local port
+         */
+        [[nodiscard]]
+        std::uint16_t port() const;
+
     private:
-        std::unique_ptr<RequestHandler> m_request_handler;
         boost::asio::io_context m_io_context;
+        boost::asio::thread_pool m_request_pool;
+        std::unique_ptr<ChannelPublisher> m_publisher;
+        std::unique_ptr<RequestHandler> m_request_handler;
         boost::asio::ip::tcp::acceptor m_acceptor;
-        std::thread m_worker;
+        std::vector<std::thread> m_workers;
 
         void runWorker();
 
@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include <functional>
 #include <utility>
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <gsl/span>
 #include "types.hpp"
 #include <atmo/device.hpp>
 
@@ -47,9 +49,23 @@ namespace atmo {
         std::size_t channels;
     };
 
+    class DeviceWorker;
+
+    class ChannelsNotifier;
+
+    /**
+     * Callback for changed channels. It is called with the device index and the new colors of all channels of the
+     * device, which are only valid during the call.
+     */
+    using ChannelsListener = std::function<void(DeviceIndex device, gsl::span<const Color> channels)>;
+
     /**
      * The Devices manager maintains all configured devices and manages lifetime and concurrency. All methods of this
      * class are thread-safe.
+     *
+     * Every device is managed by its own worker with a background writer thread, so a slow, failing or resetting device
+     * does not block the other devices. Colors submitted with submitChannels() are handed to the writer through a
+     * single slot mailbox that only keeps the newest colors.
      */
     class Devices {
     public:
@@ -60,6 +76,11 @@ namespace atmo {
          */
         explicit Devices(std::vector<Device> devices);
 
+        /**
+         * Destructor. Stops the writer threads of all devices.
+         */
+        ~Devices();
+
         /**
          * Return the number of available devices.
          *
@@ -79,7 +100,8 @@ namespace atmo {
         std::vector<DeviceInfo> devices() const;
 
         /**
-         * Set the channels of all devices to black (R: 0, G: 0, B: 0).
+         * Set the channels of all devices to black (R: 0, G: 0, B: 0). Submitted colors that have not been written yet
+         * are dropped.
          */
         void clear();
 
@@ -117,11 +139,47 @@ namespace atmo {
          */
         void setChannels(DeviceIndex device, gsl::span<const Color> channels);
 
+        /**
+         * Set a range of consecutive channels of a device to the given colors with a single device update.
+         *
+         * @param device the device index
+         * @param first the index of the first channel to set
+         * @param channels the colors for the channels starting at first
+         */
+        void setChannels(DeviceIndex device, Channel first, gsl::span<const Color> channels);
+
+        /**
+         * Set several specific channels of a device to the given colors with a single device update.
+         *
+         * @param device the device index
+         * @param channel_colors the channels to change and their new colors
+         */
+        void setChannelColors(DeviceIndex device, gsl::span<const ChannelColor> channel_colors);
+
+        /**
+         * Submit new colors for all channels of a device and return without waiting for the device. The colors are
+         * written by the writer thread of the device, replacing colors that have not been written yet. Errors are
+         * logged, failing devices are reset and retried by the writer thread if configured.
+         *
+         * @param device the device index
+         * @param channels the colors for the device channels, ordered by channel index
+         */
+        void submitChannels(DeviceIndex device, gsl::span<const Color> channels);
+
+        /**
+         * Set the listener that is notified whenever the channels of a device have been changed, either by a client or
+         * by written submitted colors. The listener is called from the thread that changed the channels and must not
+         * call back into the Devices manager. Once this method returns, the previous listener is not called anymore.
+         *
+         * @param listener the new listener or an empty function to remove the listener
+         */
+        void setChannelsListener(ChannelsListener listener);
+
     private:
-        std::mutex m_mutex;
-        std::vector<Device> m_devices;
+        std::unique_ptr<ChannelsNotifier> m_notifier;
+        std::vector<std::unique_ptr<DeviceWorker>> m_devices;
 
-        Device& getDevice(DeviceIndex device);
+        DeviceWorker& getDevice(DeviceIndex device);
     };
 
 }
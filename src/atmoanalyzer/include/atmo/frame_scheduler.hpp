@@ -0,0 +1,105 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace atmo {
+
+    /**
+     * Counters collected by the FrameScheduler.
+     */
+    struct FrameStatistics {
+        /**
+         * The number of frames that have been captured and processed.
+         */
+        std::uint64_t frames{0};
+
+        /**
+         * The number of frame slots that have been skipped, because processing took longer than one frame interval.
+         */
+        std::uint64_t dropped{0};
+
+        /**
+         * The number of capture attempts that did not deliver a frame (e.g. end of file or a device error).
+         */
+        std::uint64_t empty{0};
+    };
+
+    /**
+     * The FrameScheduler paces a processing loop to a target frame rate. Frames are scheduled at absolute deadlines, so
+     * the processing time of a frame does not add up to a drift of the frame rate. If processing falls behind by one or
+     * more whole frame intervals, the missed frame slots are skipped and accounted as dropped frames.
+     *
+     * With a target frame rate of zero, no pacing is done and frames are processed as fast as the capture device
+     * delivers them. In both modes the scheduler backs off if the capture device does not deliver any frames.
+     */
+    class FrameScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * The time to wait after an unsuccessful capture attempt if no target frame rate is set.
+         */
+        static constexpr std::chrono::milliseconds IDLE_INTERVAL{100};
+
+        /**
+         * Constructor.
+         *
+         * @param fps the target frame rate in frames per second or 0 to process frames as fast as they are delivered
+         */
+        explicit FrameScheduler(double fps);
+
+        /**
+         * (Re-)start the schedule with the first frame at the given point in time.
+         *
+         * @param now the current time
+         */
+        void start(Clock::time_point now);
+
+        /**
+         * Account the current frame and calculate the point in time at which the next frame should be processed.
+         *
+         * @param now the current time
+         * @param captured true if the current frame has been captured successfully
+         * @return the point in time to process the next frame at
+         */
+        Clock::time_point next(Clock::time_point now, bool captured);
+
+        /**
+         * Account the current frame and block until the next frame is due.
+         *
+         * @param captured true if the current frame has been captured successfully
+         */
+        void wait(bool captured);
+
+        /**
+         * Return true if the scheduler paces frames to a target frame rate.
+         *
+         * @return true if a target frame rate is set
+         */
+        [[nodiscard]]
+        bool paced() const {
+            return m_interval.count() > 0;
+        }
+
+        /**
+         * Return the collected counters.
+         *
+         * @return the frame statistics
+         */
+        [[nodiscard]]
+        const FrameStatistics& statistics() const {
+            return m_statistics;
+        }
+
+    private:
+        Clock::duration m_interval;
+        Clock::time_point m_deadline;
+        FrameStatistics m_statistics;
+    };
+
+}
@@ -0,0 +1,105 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace atmo {
+
+    /**
+     * The supported memory layouts of captured images.
+     */
+    enum class PixelFormat {
+        /**
+         * Packed 24 bit pixels in blue, green, red order (e.g. OpenCV images).
+         */
+        BGR,
+
+        /**
+         * Packed 24 bit pixels in red, green, blue order.
+         */
+        RGB,
+
+        /**
+         * Packed 32 bit pixels in blue, green, red, alpha order. The alpha channel is ignored.
+         */
+        BGRA,
+
+        /**
+         * Packed YUV 4:2:2 with two pixels per 32 bit macro pixel in Y0, U, Y1, V order.
+         */
+        YUYV,
+
+        /**
+         * Planar YUV 4:2:0 with a full resolution Y plane and a half resolution plane of interleaved U, V samples. The
+         * second plane is given by ImageView::chroma.
+         */
+        NV12
+    };
+
+    /**
+     * A non-owning view to the pixel data of a captured image.
+     */
+    struct ImageView {
+        /**
+         * The first byte of the first row.
+         */
+        const std::uint8_t* data{nullptr};
+
+        /**
+         * The width in pixels.
+         */
+        int width{0};
+
+        /**
+         * The height in pixels.
+         */
+        int height{0};
+
+        /**
+         * The distance between the beginning of two consecutive rows in bytes.
+         */
+        std::size_t stride{0};
+
+        /**
+         * The memory layout of the pixels.
+         */
+        PixelFormat format{PixelFormat::BGR};
+
+        /**
+         * The first byte of the first row of the chroma plane (only used by planar formats).
+         */
+        const std::uint8_t* chroma{nullptr};
+
+        /**
+         * The distance between the beginning of two consecutive rows of the chroma plane in bytes.
+         */
+        std::size_t chroma_stride{0};
+
+        /**
+         * Return the first byte of the given row.
+         *
+         * @param y the row index
+         * @return a pointer to the beginning of the row
+         */
+        [[nodiscard]]
+        const std::uint8_t* row(int y) const {
+            return data + static_cast<std::size_t>(y) * stride;
+        }
+
+        /**
+         * Return the first byte of the chroma plane row that belongs to the given image row.
+         *
+         * @param y the image row index
+         * @return a pointer to the beginning of the chroma row
+         */
+        [[nodiscard]]
+        const std::uint8_t* chromaRow(int y) const {
+            return chroma + static_cast<std::size_t>(y / 2) * chroma_stride;
+        }
+    };
+
+}
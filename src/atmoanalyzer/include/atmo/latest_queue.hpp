@@ -0,0 +1,190 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace atmo {
+
+    /**
+     * A bounded single-producer/single-consumer queue that only keeps the newest value ("latest wins"). The queue is a
+     * ring of three preallocated slots (a triple buffer): the producer owns one slot for writing, the consumer owns one
+     * slot for reading and the third slot holds the newest published value. Publishing replaces a value that has not
+     * been consumed yet, so the producer never blocks and the consumer always receives the freshest value.
+     *
+     * Values are exchanged lock-free. The mutex and the condition variable are only used to put an idle consumer to
+     * sleep, so publishing only takes the mutex while the consumer is waiting. The slots are reused, so the producer
+     * has to overwrite all relevant parts of the value in back().
+     *
+     * @tparam T the value type
+     */
+    template<class T>
+    class LatestQueue {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param initial the initial value of all slots
+         */
+        explicit LatestQueue(const T& initial = T{}) :
+                m_slots{initial, initial, initial},
+                m_back{0},
+                m_middle{1},
+                m_front{2},
+                m_published{0},
+                m_dropped{0},
+                m_interrupted{false},
+                m_waiting{false},
+                m_mutex{},
+                m_condition_variable{} {}
+
+        LatestQueue(const LatestQueue&) = delete;
+
+        LatestQueue& operator=(const LatestQueue&) = delete;
+
+        /**
+         * Return the slot the producer writes the next value to. Must only be called by the producer.
+         *
+         * @return the producer slot
+         */
+        T& back() {
+            return m_slots[m_back];
+        }
+
+        /**
+         * Publish the value in back() to the consumer. A previously published value that has not been consumed yet is
+         * dropped. Must only be called by the producer.
+         */
+        void publish() {
+            const auto previous = m_middle.exchange(static_cast<std::uint8_t>(m_back | FRESH),
+                                                    std::memory_order_acq_rel);
+            m_back = previous & INDEX_MASK;
+            m_published.fetch_add(1, std::memory_order_relaxed);
+            if (previous & FRESH) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            notify();
+        }
+
+        /**
+         * Take the newest published value, if any. Must only be called by the consumer.
+         *
+         * @return true if a new value is available in front()
+         */
+        bool consume() {
+            if (!(m_middle.load(std::memory_order_acquire) & FRESH)) {
+                return false;
+            }
+            const auto previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = previous & INDEX_MASK;
+            return true;
+        }
+
+        /**
+         * Wait until a new value has been published and take it. Must only be called by the consumer.
+         *
+         * @param timeout the maximum time to wait
+         * @return true if a new value is available in front(), false on timeout or if the queue has been interrupted
+         */
+        template<class Rep, class Period>
+        bool waitAndConsume(std::chrono::duration<Rep, Period> timeout) {
+            if (consume()) {
+                return true;
+            }
+            std::unique_lock<std::mutex> lock{m_mutex};
+            m_waiting.store(true, std::memory_order_relaxed);
+            // Pairs with the fence in notify(): either the producer sees the waiting consumer or the consumer sees the
+            // published value.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_condition_variable.wait_for(lock, timeout, [this]() { return m_interrupted || depth() > 0; });
+            m_waiting.store(false, std::memory_order_relaxed);
+            lock.unlock();
+            return consume();
+        }
+
+        /**
+         * Return the value that has been consumed last. Must only be called by the consumer.
+         *
+         * @return the consumer slot
+         */
+        T& front() {
+            return m_slots[m_front];
+        }
+
+        /**
+         * Wake up a waiting consumer and make all further waits return immediately.
+         */
+        void interrupt() {
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_interrupted = true;
+            }
+            m_condition_variable.notify_all();
+        }
+
+        /**
+         * Return the number of published values that have not been consumed yet (0 or 1).
+         *
+         * @return the number of pending values
+         */
+        [[nodiscard]]
+        std::size_t depth() const {
+            return (m_middle.load(std::memory_order_acquire) & FRESH) ? 1 : 0;
+        }
+
+        /**
+         * Return the total number of published values.
+         *
+         * @return the number of published values
+         */
+        [[nodiscard]]
+        std::uint64_t published() const {
+            return m_published.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Return the number of values that have been replaced before the consumer could take them.
+         *
+         * @return the number of dropped values
+         */
+        [[nodiscard]]
+        std::uint64_t dropped() const {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr std::uint8_t INDEX_MASK{0b011};
+        static constexpr std::uint8_t FRESH{0b100};
+
+        std::array<T, 3> m_slots;
+        std::uint8_t m_back;
+        std::atomic<std::uint8_t> m_middle;
+        std::uint8_t m_front;
+        std::atomic<std::uint64_t> m_published;
+        std::atomic<std::uint64_t> m_dropped;
+        bool m_interrupted;
+        std::atomic<bool> m_waiting;
+        std::mutex m_mutex;
+        std::condition_variable m_condition_variable;
+
+        void notify() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!m_waiting.load(std::memory_order_relaxed)) {
+                return;
+            }
+            {
+                // Synchronize with a consumer that is about to wait, otherwise the notification could get lost.
+                std::lock_guard<std::mutex> lock{m_mutex};
+            }
+            m_condition_variable.notify_one();
+        }
+    };
+
+}
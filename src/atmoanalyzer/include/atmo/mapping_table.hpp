@@ -0,0 +1,89 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <gsl/span>
+#include "devices.hpp"
+#include "types.hpp"
+
+namespace atmo {
+
+    /**
+     * The MappingTable is the compiled form of the Mappings from the input channels to the device channels.
+     *
+     * The input channels are addressed in the order of Channels::all() (top, bottom, left, right). The channels of all
+     * devices are stored in one contiguous output buffer, ordered by device index. For every input channel, the table
+     * holds the index of its target in the output buffer, so mapping a frame is a single scatter loop without any
+     * bounds checks. All mappings are validated once when the table is compiled.
+     */
+    class MappingTable {
+    public:
+        /**
+         * Compile and validate the given mappings.
+         *
+         * @param mappings the mappings from input channels to devices and device channels
+         * @param channel_configs the layout of the input channels
+         * @param devices the available devices
+         * @throws std::runtime_error if an input channel has no mapping or a mapping refers to a device or channel that
+         * does not exist
+         */
+        MappingTable(const Mappings& mappings,
+                     const ChannelConfigs& channel_configs,
+                     const std::vector<DeviceInfo>& devices);
+
+        /**
+         * Return the number of input channels.
+         *
+         * @return the number of input channels
+         */
+        [[nodiscard]]
+        std::size_t inputs() const {
+            return m_targets.size();
+        }
+
+        /**
+         * Return the size of the output buffer (the number of channels of all devices).
+         *
+         * @return the number of output channels
+         */
+        [[nodiscard]]
+        std::size_t outputs() const {
+            return m_device_offsets.back();
+        }
+
+        /**
+         * Copy the input channels to their mapped positions in the output buffer. Output channels without a mapping are
+         * left unchanged.
+         *
+         * @param input_channels the input channels, sized inputs()
+         * @param output_channels the output buffer, sized outputs()
+         */
+        void apply(gsl::span<const Color> input_channels, gsl::span<Color> output_channels) const;
+
+        /**
+         * Return the channels of one device within the output buffer.
+         *
+         * @param output_channels the output buffer
+         * @param device the device index
+         * @return the channels of the device
+         */
+        [[nodiscard]]
+        gsl::span<const Color> deviceChannels(gsl::span<const Color> output_channels, DeviceIndex device) const {
+            return output_channels.subspan(static_cast<std::ptrdiff_t>(m_device_offsets[device]),
+                                           static_cast<std::ptrdiff_t>(m_device_offsets[device + 1]
+                                                                       - m_device_offsets[device]));
+        }
+
+    private:
+        std::vector<std::size_t> m_device_offsets;
+        std::vector<std::size_t> m_targets;
+
+        void compileSide(const char* side, const std::vector<Mapping>& mappings, Channel count);
+    };
+
+}
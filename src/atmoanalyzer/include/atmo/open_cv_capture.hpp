@@ -8,6 +8,7 @@
 
 #include <opencv2/videoio.hpp>
 #include <atmo/capture_device.hpp>
+#include <atmo/border_analyzer.hpp>
 
 namespace atmo {
 
@@ -38,22 +39,12 @@ namespace atmo {
 
         /*! @copydoc CaptureDevice::capture()
          */
-        Channels capture() final;
+        bool capture(Channels& channels) final;
 
     private:
-        ChannelConfigs m_channel_configs;
+        BorderAnalyzer m_border_analyzer;
         cv::VideoCapture m_capture_device;
         cv::Mat m_current_frame;
-
-        std::vector<Color> calculateTopChannels() const;
-
-        std::vector<Color> calculateBottomChannels() const;
-
-        std::vector<Color> calculateLeftChannels() const;
-
-        std::vector<Color> calculateRightChannels() const;
-
-        Color getMean(const cv::Rect& rect) const;
     };
 
 }
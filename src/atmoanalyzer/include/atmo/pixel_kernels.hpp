@@ -0,0 +1,80 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace atmo {
+
+    /**
+     * A set of pixel accumulation and filter functions, implemented for one instruction set. The functions work on raw
+     * bytes, so they can be used for all packed and planar pixel formats.
+     */
+    struct PixelKernels {
+        /**
+         * The name of the instruction set (e.g. "avx2").
+         */
+        const char* name;
+
+        /**
+         * Add count bytes to count 32 bit accumulators: sums[i] += bytes[i]. This is used to sum up the rows of a strip
+         * per column.
+         *
+         * @param bytes the bytes to add
+         * @param count the number of bytes
+         * @param sums the accumulators
+         */
+        void (* accumulate)(const std::uint8_t* bytes, std::size_t count, std::uint32_t* sums);
+
+        /**
+         * Sum up interleaved components: sums[i % components] += bytes[i]. This is used to sum up the pixels of a row
+         * per color component.
+         *
+         * @param bytes the interleaved bytes
+         * @param count the number of bytes, must be a multiple of components
+         * @param components the number of interleaved components (1 to 4)
+         * @param sums the accumulators, one per component
+         */
+        void (* sumInterleaved)(const std::uint8_t* bytes,
+                                std::size_t count,
+                                std::size_t components,
+                                std::uint32_t* sums);
+
+        /**
+         * Move a fixed point state towards the given bytes by one step of an exponential moving average and write the
+         * rounded state: state[i] += round((bytes[i] * 128 - state[i]) * weight / 32768) and
+         * smoothed[i] = round(state[i] / 128). The state holds values with 7 fractional bits. bytes and smoothed may
+         * point to the same memory.
+         *
+         * @param bytes the new bytes
+         * @param count the number of bytes
+         * @param weight the weight of the new bytes (0 to 32767)
+         * @param state the fixed point state, one value per byte
+         * @param smoothed the smoothed bytes
+         */
+        void (* smooth)(const std::uint8_t* bytes,
+                        std::size_t count,
+                        std::int16_t weight,
+                        std::int16_t* state,
+                        std::uint8_t* smoothed);
+    };
+
+    /**
+     * Return the fastest pixel kernels supported by the CPU. The instruction set is detected once at runtime.
+     *
+     * @return the selected pixel kernels
+     */
+    const PixelKernels& pixelKernels();
+
+    /**
+     * Return all pixel kernels that are supported by the CPU, starting with the portable scalar implementation.
+     *
+     * @return the supported pixel kernels
+     */
+    std::vector<const PixelKernels*> supportedPixelKernels();
+
+}
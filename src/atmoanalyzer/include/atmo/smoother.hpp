@@ -0,0 +1,79 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <gsl/span>
+#include <atmo/channel.hpp>
+#include "pixel_kernels.hpp"
+
+namespace atmo {
+
+    /**
+     * Configuration of the temporal smoothing of the analyzed channels.
+     */
+    struct SmoothingConfig {
+        /**
+         * The time constant of the exponential moving average. After this time, a channel has moved about 63% of the
+         * way to a new color. Zero disables smoothing. A frame always moves a channel at least 1/128 of the way, so the
+         * smoothing does not stall at high frame rates. Time constants above 128 frame intervals are shortened to that.
+         */
+        std::chrono::milliseconds time_constant{0};
+
+        /**
+         * If the mean difference of all color components between a new frame and the smoothed colors exceeds this
+         * value (1 to 255), the frame is taken as is without smoothing. Zero disables the scene cut detection.
+         */
+        std::uint8_t scene_cut_threshold{0};
+    };
+
+    /**
+     * The Smoother filters the channels of consecutive frames by an exponential moving average in fixed point
+     * arithmetic, using the vectorized pixel kernels. The weight of each new frame is derived from the measured time
+     * since the previous frame, so the smoothing looks the same at all frame rates.
+     */
+    class Smoother {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * Constructor.
+         *
+         * @param config the smoothing configuration
+         */
+        explicit Smoother(const SmoothingConfig& config);
+
+        /**
+         * Return whether smoothing is enabled.
+         *
+         * @return true if frames are smoothed
+         */
+        [[nodiscard]]
+        bool enabled() const;
+
+        /**
+         * Replace the given channels by their smoothed colors.
+         *
+         * @param channels the channels of the new frame, smoothed in place
+         * @param time the time of the new frame
+         */
+        void apply(gsl::span<Color> channels, Clock::time_point time);
+
+    private:
+        SmoothingConfig m_config;
+        const PixelKernels* m_kernels;
+        std::vector<std::int16_t> m_state;
+        std::optional<Clock::time_point> m_last_time;
+
+        [[nodiscard]]
+        bool sceneCut(gsl::span<const std::uint8_t> bytes) const;
+
+        void reset(gsl::span<const std::uint8_t> bytes);
+    };
+
+}
@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
+#include <gsl/span>
 #include <atmo/channel.hpp>
 
 namespace atmo {
@@ -34,6 +36,18 @@ namespace atmo {
          * The number of outer pixels to crop and ignore.
          */
         Width crop{0};
+
+        /**
+         * Only analyze every n-th column of the areas. Values greater than 1 reduce the number of pixels to read at
+         * the cost of precision. The stride along the side is limited to the length of one area.
+         */
+        Width stride_x{1};
+
+        /**
+         * Only analyze every n-th row of the areas. Values greater than 1 reduce the number of pixels to read at the
+         * cost of precision. The stride along the side is limited to the length of one area.
+         */
+        Width stride_y{1};
     };
 
     /**
@@ -48,27 +62,117 @@ namespace atmo {
 
     /**
      * The color data for all four available areas. The number of channels per area can be configured by the user.
+     *
+     * The colors of all areas are stored in one contiguous buffer in top, bottom, left, right order. Resizing reuses
+     * the buffer, so a Channels instance that is filled repeatedly with the same layout does not allocate memory.
      */
-    struct Channels {
+    class Channels {
+    public:
+        /**
+         * Set the number of channels per area. The colors are undefined afterwards.
+         *
+         * @param top the number of top channels
+         * @param bottom the number of bottom channels
+         * @param left the number of left channels
+         * @param right the number of right channels
+         */
+        void resize(std::size_t top, std::size_t bottom, std::size_t left, std::size_t right) {
+            m_offsets = {0, top, top + bottom, top + bottom + left, top + bottom + left + right};
+            m_colors.resize(m_offsets[4]);
+        }
+
+        /**
+         * Remove all channels.
+         */
+        void clear() {
+            resize(0, 0, 0, 0);
+        }
+
+        /**
+         * Return true if there are no channels in any area.
+         *
+         * @return true if empty
+         */
+        [[nodiscard]]
+        bool empty() const {
+            return m_colors.empty();
+        }
+
         /**
          * The top channels.
          */
-        std::vector<Color> top{};
+        gsl::span<Color> top() {
+            return area(0);
+        }
+
+        [[nodiscard]]
+        gsl::span<const Color> top() const {
+            return area(0);
+        }
 
         /**
          * The bottom channels.
          */
-        std::vector<Color> bottom{};
+        gsl::span<Color> bottom() {
+            return area(1);
+        }
+
+        [[nodiscard]]
+        gsl::span<const Color> bottom() const {
+            return area(1);
+        }
 
         /**
          * The left channels.
          */
-        std::vector<Color> left{};
+        gsl::span<Color> left() {
+            return area(2);
+        }
+
+        [[nodiscard]]
+        gsl::span<const Color> left() const {
+            return area(2);
+        }
 
         /**
          * The right channels.
          */
-        std::vector<Color> right{};
+        gsl::span<Color> right() {
+            return area(3);
+        }
+
+        [[nodiscard]]
+        gsl::span<const Color> right() const {
+            return area(3);
+        }
+
+        /**
+         * All channels in top, bottom, left, right order.
+         */
+        [[nodiscard]]
+        gsl::span<Color> all() {
+            return {m_colors.data(), static_cast<std::ptrdiff_t>(m_colors.size())};
+        }
+
+        [[nodiscard]]
+        gsl::span<const Color> all() const {
+            return {m_colors.data(), static_cast<std::ptrdiff_t>(m_colors.size())};
+        }
+
+    private:
+        std::vector<Color> m_colors{};
+        std::array<std::size_t, 5> m_offsets{};
+
+        gsl::span<Color> area(std::size_t index) {
+            return {m_colors.data() + m_offsets[index],
+                    static_cast<std::ptrdiff_t>(m_offsets[index + 1] - m_offsets[index])};
+        }
+
+        [[nodiscard]]
+        gsl::span<const Color> area(std::size_t index) const {
+            return {m_colors.data() + m_offsets[index],
+                    static_cast<std::ptrdiff_t>(m_offsets[index + 1] - m_offsets[index])};
+        }
     };
 
     /**
@@ -101,7 +205,12 @@ namespace atmo {
         /**
          * OpenCV capture and analysis.
          */
-        OpenCV
+        OpenCV,
+
+        /**
+         * Video4Linux2 capture with memory mapped buffers.
+         */
+        V4L2
     };
 
     /**
@@ -121,7 +230,67 @@ namespace atmo {
         /**
          * Adafruit Dotstar.
          */
-        DotStar
+        DotStar,
+
+        /**
+         * APA102 LED strip.
+         */
+        APA102,
+
+        /**
+         * SK9822 LED strip.
+         */
+        SK9822,
+
+        /**
+         * WS2801 LED strip.
+         */
+        WS2801,
+
+        /**
+         * LPD8806 LED strip.
+         */
+        LPD8806,
+
+        /**
+         * P9813 LED chain.
+         */
+        P9813,
+
+        /**
+         * Network receiver using the Distributed Display Protocol (e.g. WLED).
+         */
+        DDP,
+
+        /**
+         * Network receiver using E1.31 (Streaming ACN).
+         */
+        E131,
+
+        /**
+         * Network receiver using Art-Net.
+         */
+        ArtNet,
+
+        /**
+         * Virtual device that discards all frames.
+         */
+        Null,
+
+        /**
+         * Virtual device that records the most recent frames in memory.
+         */
+        Memory,
+
+        /**
+         * Virtual device that writes raw RGB frames to a file.
+         */
+        File,
+
+        /**
+         * Virtual device that writes raw RGB frames to a named pipe.
+         */
+        Fifo
     };
 
 }
\ No newline at end of file
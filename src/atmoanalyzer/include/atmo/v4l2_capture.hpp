@@ -0,0 +1,140 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#ifdef WITH_V4L2
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <atmo/capture_device.hpp>
+#include <atmo/border_analyzer.hpp>
+
+namespace atmo {
+
+    /**
+     * CaptureDevice implementation that uses the Video4Linux2 streaming API directly. The frames are captured into
+     * memory mapped driver buffers and analyzed in place in their native pixel format (YUYV, NV12, RGB24 or BGR24),
+     * so no decoding, color conversion or copying of whole frames is necessary.
+     *
+     * Only single-planar capture devices are supported. Without real hardware, the implementation can be used with a
+     * v4l2loopback device that is fed by e.g. ffmpeg. Child classes can provide their own buffers by overriding
+     * dequeueBuffer() and queueBuffer(), e.g. to test the capture without a device.
+     *
+     * This implementation is only available on Linux systems with the V4L2 headers installed.
+     */
+    class V4L2Capture : public CaptureDevice {
+    public:
+        /**
+         * Configuration of the capture format. All values are optional and default to the current format of the device.
+         * The driver may adjust the resolution to the nearest supported one.
+         */
+        struct Format {
+            /**
+             * The requested frame width in pixels.
+             */
+            std::optional<int> width{};
+
+            /**
+             * The requested frame height in pixels.
+             */
+            std::optional<int> height{};
+
+            /**
+             * The requested pixel format. If not set, YUYV and NV12 are tried in this order.
+             */
+            std::optional<PixelFormat> pixel_format{};
+        };
+
+        /**
+         * Create a new CaptureDevice instance and start streaming.
+         *
+         * @param filename the device file (e.g. /dev/video0)
+         * @param format the requested capture format
+         * @param channel_configs the channel mapping configuration to use for creating the output channels
+         */
+        V4L2Capture(const std::string& filename, const Format& format, ChannelConfigs channel_configs);
+
+        ~V4L2Capture() override;
+
+        V4L2Capture(const V4L2Capture&) = delete;
+
+        V4L2Capture& operator=(const V4L2Capture&) = delete;
+
+        /*! @copydoc CaptureDevice::capture()
+         */
+        bool capture(Channels& channels) final;
+
+    protected:
+        /**
+         * A capture buffer, memory mapped from the driver unless provided by a child class.
+         */
+        struct Buffer {
+            void* data;
+            std::size_t length;
+        };
+
+        /**
+         * A buffer that has been filled by the driver.
+         */
+        struct DequeuedBuffer {
+            /**
+             * The index of the buffer.
+             */
+            std::uint32_t index;
+
+            /**
+             * The number of bytes the driver has written into the buffer, 0 if unknown.
+             */
+            std::uint32_t bytes_used;
+
+            /**
+             * Whether the driver has reported an error, e.g. a corrupted frame.
+             */
+            bool error;
+        };
+
+        /**
+         * Constructor for child classes that provide their own buffers instead of opening a device.
+         *
+         * @param format the layout of the frames in the buffers, the data pointers are ignored
+         * @param buffers the capture buffers, which are owned by the caller
+         * @param channel_configs the channel mapping configuration to use for creating the output channels
+         */
+        V4L2Capture(const ImageView& format, std::vector<Buffer> buffers, ChannelConfigs channel_configs);
+
+        /**
+         * Wait for the next filled buffer and take it from the driver.
+         *
+         * @return the filled buffer or nothing if no frame is available
+         */
+        virtual std::optional<DequeuedBuffer> dequeueBuffer();
+
+        /**
+         * Hand a buffer back to the driver to be filled again.
+         *
+         * @param index the index of the buffer
+         */
+        virtual void queueBuffer(std::uint32_t index);
+
+    private:
+        std::string m_filename;
+        int m_file_descriptor;
+        BorderAnalyzer m_border_analyzer;
+        ImageView m_image;
+        std::vector<Buffer> m_buffers;
+        bool m_streaming;
+
+        void configureFormat(const Format& format);
+
+        void mapBuffers();
+
+        void closeDevice();
+    };
+
+}
+
+#endif
@@ -0,0 +1,71 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <atmo/mapping_table.hpp>
+
+#include <stdexcept>
+#include <fmt/format.h>
+
+namespace atmo {
+
+    MappingTable::MappingTable(const Mappings& mappings,
+                               const ChannelConfigs& channel_configs,
+                               const std::vector<DeviceInfo>& devices) :
+            m_device_offsets{},
+            m_targets{} {
+        m_device_offsets.reserve(devices.size() + 1);
+        m_device_offsets.push_back(0);
+        for (const auto& device : devices) {
+            m_device_offsets.push_back(m_device_offsets.back() + device.channels);
+        }
+
+        m_targets.reserve(channel_configs.top.count
+                          + channel_configs.bottom.count
+                          + channel_configs.left.count
+                          + channel_configs.right.count);
+        compileSide("top", mappings.top, channel_configs.top.count);
+        compileSide("bottom", mappings.bottom, channel_configs.bottom.count);
+        compileSide("left", mappings.left, channel_configs.left.count);
+        compileSide("right", mappings.right, channel_configs.right.count);
+    }
+
+    void MappingTable::compileSide(const char* side, const std::vector<Mapping>& mappings, Channel count) {
+        if (mappings.size() < count) {
+            throw std::runtime_error{fmt::format("Missing {} mappings: {} channels configured but only {} mapped",
+                                                 side, count, mappings.size())};
+        }
+        const auto devices = m_device_offsets.size() - 1;
+        for (Channel channel = 0; channel < count; ++channel) {
+            const auto& mapping = mappings[channel];
+            if (mapping.device_index >= devices) {
+                throw std::runtime_error{fmt::format("Invalid {} mapping {}: device index {} out of range ({} devices)",
+                                                     side, channel, mapping.device_index, devices)};
+            }
+            const auto offset = m_device_offsets[mapping.device_index];
+            const auto device_channels = m_device_offsets[mapping.device_index + 1] - offset;
+            if (mapping.device_channel >= device_channels) {
+                throw std::runtime_error{fmt::format(
+                        "Invalid {} mapping {}: device channel {} out of range (device {} has {} channels)",
+                        side, channel, mapping.device_channel, mapping.device_index, device_channels)};
+            }
+            m_targets.push_back(offset + mapping.device_channel);
+        }
+    }
+
+    void MappingTable::apply(gsl::span<const Color> input_channels, gsl::span<Color> output_channels) const {
+        if (static_cast<std::size_t>(input_channels.size()) != inputs()
+            || static_cast<std::size_t>(output_channels.size()) != outputs()) {
+            throw std::runtime_error{fmt::format("Invalid channel layout: expected {} input and {} output channels "
+                                                 "but got {} and {}",
+                                                 inputs(), outputs(), input_channels.size(), output_channels.size())};
+        }
+        const auto* source = input_channels.data();
+        auto* target = output_channels.data();
+        const auto* targets = m_targets.data();
+        for (std::size_t i = 0; i < m_targets.size(); ++i) {
+            target[targets[i]] = source[i];
+        }
+    }
+
+}
@@ -0,0 +1,363 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <atmo/pixel_kernels.hpp>
+
+#include <spdlog/spdlog.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ATMO_X86_KERNELS
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define ATMO_NEON_KERNELS
+#include <arm_neon.h>
+#if defined(__linux__) && !defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+namespace {
+
+    using namespace atmo;
+
+    /**
+     * The number of bytes processed per iteration by the vectorized sumInterleaved() implementations. 48 bytes is a
+     * multiple of all supported component counts, so every vector lane always accumulates the same component.
+     */
+    constexpr std::size_t INTERLEAVED_BLOCK{48};
+
+    void accumulateScalar(const std::uint8_t* bytes, std::size_t count, std::uint32_t* sums) {
+        for (std::size_t i = 0; i < count; ++i) {
+            sums[i] += bytes[i];
+        }
+    }
+
+    void sumInterleavedTail(const std::uint8_t* bytes,
+                            std::size_t begin,
+                            std::size_t count,
+                            std::size_t components,
+                            std::uint32_t* sums) {
+        for (auto i = begin; i < count; ++i) {
+            sums[i % components] += bytes[i];
+        }
+    }
+
+    void sumLanes(const std::uint32_t* lanes, std::size_t components, std::uint32_t* sums) {
+        for (std::size_t lane = 0; lane < INTERLEAVED_BLOCK; ++lane) {
+            sums[lane % components] += lanes[lane];
+        }
+    }
+
+    void sumInterleavedScalar(const std::uint8_t* bytes,
+                              std::size_t count,
+                              std::size_t components,
+                              std::uint32_t* sums) {
+        sumInterleavedTail(bytes, 0, count, components, sums);
+    }
+
+    /**
+     * The number of fractional bits of the smoothing state.
+     */
+    constexpr int SMOOTH_SHIFT{7};
+
+    void smoothScalar(const std::uint8_t* bytes,
+                      std::size_t count,
+                      std::int16_t weight,
+                      std::int16_t* state,
+                      std::uint8_t* smoothed) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const int delta = (bytes[i] << SMOOTH_SHIFT) - state[i];
+            // Rounds like the multiply high with round instructions of the vectorized implementations.
+            state[i] = static_cast<std::int16_t>(state[i] + ((((delta * weight) >> 14) + 1) >> 1));
+            smoothed[i] = static_cast<std::uint8_t>((state[i] + (1 << (SMOOTH_SHIFT - 1))) >> SMOOTH_SHIFT);
+        }
+    }
+
+    constexpr PixelKernels SCALAR_KERNELS{"scalar", accumulateScalar, sumInterleavedScalar, smoothScalar};
+
+#ifdef ATMO_X86_KERNELS
+
+    __attribute__((target("sse4.1")))
+    void addWidened(__m128i bytes, std::uint32_t* sums) {
+        auto* target = reinterpret_cast<__m128i*>(sums);
+        _mm_storeu_si128(target, _mm_add_epi32(_mm_loadu_si128(target), _mm_cvtepu8_epi32(bytes)));
+    }
+
+    __attribute__((target("sse4.1")))
+    void accumulateSse41(const std::uint8_t* bytes, std::size_t count, std::uint32_t* sums) {
+        std::size_t i{0};
+        for (; i + 16 <= count; i += 16) {
+            const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+            addWidened(block, sums + i);
+            addWidened(_mm_srli_si128(block, 4), sums + i + 4);
+            addWidened(_mm_srli_si128(block, 8), sums + i + 8);
+            addWidened(_mm_srli_si128(block, 12), sums + i + 12);
+        }
+        accumulateScalar(bytes + i, count - i, sums + i);
+    }
+
+    __attribute__((target("sse4.1")))
+    void sumInterleavedSse41(const std::uint8_t* bytes,
+                             std::size_t count,
+                             std::size_t components,
+                             std::uint32_t* sums) {
+        __m128i accumulators[12];
+        for (auto& accumulator : accumulators) {
+            accumulator = _mm_setzero_si128();
+        }
+
+        std::size_t i{0};
+        for (; i + INTERLEAVED_BLOCK <= count; i += INTERLEAVED_BLOCK) {
+            for (std::size_t part = 0; part < 3; ++part) {
+                const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i + part * 16));
+                auto* accumulator = accumulators + part * 4;
+                accumulator[0] = _mm_add_epi32(accumulator[0], _mm_cvtepu8_epi32(block));
+                accumulator[1] = _mm_add_epi32(accumulator[1], _mm_cvtepu8_epi32(_mm_srli_si128(block, 4)));
+                accumulator[2] = _mm_add_epi32(accumulator[2], _mm_cvtepu8_epi32(_mm_srli_si128(block, 8)));
+                accumulator[3] = _mm_add_epi32(accumulator[3], _mm_cvtepu8_epi32(_mm_srli_si128(block, 12)));
+            }
+        }
+
+        alignas(16) std::uint32_t lanes[INTERLEAVED_BLOCK];
+        for (std::size_t accumulator = 0; accumulator < 12; ++accumulator) {
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes + accumulator * 4), accumulators[accumulator]);
+        }
+        sumLanes(lanes, components, sums);
+        sumInterleavedTail(bytes, i, count, components, sums);
+    }
+
+    __attribute__((target("sse4.1")))
+    __m128i smoothStep(__m128i bytes, __m128i weights, std::int16_t* state) {
+        auto* target = reinterpret_cast<__m128i*>(state);
+        auto current = _mm_loadu_si128(target);
+        const auto delta = _mm_sub_epi16(_mm_slli_epi16(bytes, SMOOTH_SHIFT), current);
+        current = _mm_add_epi16(current, _mm_mulhrs_epi16(delta, weights));
+        _mm_storeu_si128(target, current);
+        return _mm_srli_epi16(_mm_add_epi16(current, _mm_set1_epi16(1 << (SMOOTH_SHIFT - 1))), SMOOTH_SHIFT);
+    }
+
+    __attribute__((target("sse4.1")))
+    void smoothSse41(const std::uint8_t* bytes,
+                     std::size_t count,
+                     std::int16_t weight,
+                     std::int16_t* state,
+                     std::uint8_t* smoothed) {
+        const auto weights = _mm_set1_epi16(weight);
+        std::size_t i{0};
+        for (; i + 16 <= count; i += 16) {
+            const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+            const auto low = smoothStep(_mm_cvtepu8_epi16(block), weights, state + i);
+            const auto high = smoothStep(_mm_cvtepu8_epi16(_mm_srli_si128(block, 8)), weights, state + i + 8);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(smoothed + i), _mm_packus_epi16(low, high));
+        }
+        smoothScalar(bytes + i, count - i, weight, state + i, smoothed + i);
+    }
+
+    constexpr PixelKernels SSE41_KERNELS{"sse4.1", accumulateSse41, sumInterleavedSse41, smoothSse41};
+
+    __attribute__((target("avx2")))
+    __m256i loadWidened(const std::uint8_t* bytes) {
+        return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(bytes)));
+    }
+
+    __attribute__((target("avx2")))
+    void accumulateAvx2(const std::uint8_t* bytes, std::size_t count, std::uint32_t* sums) {
+        std::size_t i{0};
+        for (; i + 32 <= count; i += 32) {
+            for (std::size_t part = 0; part < 32; part += 8) {
+                auto* target = reinterpret_cast<__m256i*>(sums + i + part);
+                _mm256_storeu_si256(target, _mm256_add_epi32(_mm256_loadu_si256(target),
+                                                             loadWidened(bytes + i + part)));
+            }
+        }
+        accumulateScalar(bytes + i, count - i, sums + i);
+    }
+
+    __attribute__((target("avx2")))
+    void sumInterleavedAvx2(const std::uint8_t* bytes,
+                            std::size_t count,
+                            std::size_t components,
+                            std::uint32_t* sums) {
+        __m256i accumulators[6];
+        for (auto& accumulator : accumulators) {
+            accumulator = _mm256_setzero_si256();
+        }
+
+        std::size_t i{0};
+        for (; i + INTERLEAVED_BLOCK <= count; i += INTERLEAVED_BLOCK) {
+            for (std::size_t part = 0; part < 6; ++part) {
+                accumulators[part] = _mm256_add_epi32(accumulators[part], loadWidened(bytes + i + part * 8));
+            }
+        }
+
+        alignas(32) std::uint32_t lanes[INTERLEAVED_BLOCK];
+        for (std::size_t accumulator = 0; accumulator < 6; ++accumulator) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes + accumulator * 8), accumulators[accumulator]);
+        }
+        sumLanes(lanes, components, sums);
+        sumInterleavedTail(bytes, i, count, components, sums);
+    }
+
+    __attribute__((target("avx2")))
+    void smoothAvx2(const std::uint8_t* bytes,
+                    std::size_t count,
+                    std::int16_t weight,
+                    std::int16_t* state,
+                    std::uint8_t* smoothed) {
+        const auto weights = _mm256_set1_epi16(weight);
+        const auto rounding = _mm256_set1_epi16(1 << (SMOOTH_SHIFT - 1));
+        std::size_t i{0};
+        for (; i + 16 <= count; i += 16) {
+            const auto block = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i)));
+            auto* target = reinterpret_cast<__m256i*>(state + i);
+            auto current = _mm256_loadu_si256(target);
+            const auto delta = _mm256_sub_epi16(_mm256_slli_epi16(block, SMOOTH_SHIFT), current);
+            current = _mm256_add_epi16(current, _mm256_mulhrs_epi16(delta, weights));
+            _mm256_storeu_si256(target, current);
+            const auto output = _mm256_srli_epi16(_mm256_add_epi16(current, rounding), SMOOTH_SHIFT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(smoothed + i),
+                             _mm_packus_epi16(_mm256_castsi256_si128(output), _mm256_extracti128_si256(output, 1)));
+        }
+        smoothScalar(bytes + i, count - i, weight, state + i, smoothed + i);
+    }
+
+    constexpr PixelKernels AVX2_KERNELS{"avx2", accumulateAvx2, sumInterleavedAvx2, smoothAvx2};
+
+#endif
+
+#ifdef ATMO_NEON_KERNELS
+
+    void accumulateNeon(const std::uint8_t* bytes, std::size_t count, std::uint32_t* sums) {
+        std::size_t i{0};
+        for (; i + 16 <= count; i += 16) {
+            const auto block = vld1q_u8(bytes + i);
+            const auto low = vmovl_u8(vget_low_u8(block));
+            const auto high = vmovl_u8(vget_high_u8(block));
+            auto* target = sums + i;
+            vst1q_u32(target, vaddw_u16(vld1q_u32(target), vget_low_u16(low)));
+            vst1q_u32(target + 4, vaddw_u16(vld1q_u32(target + 4), vget_high_u16(low)));
+            vst1q_u32(target + 8, vaddw_u16(vld1q_u32(target + 8), vget_low_u16(high)));
+            vst1q_u32(target + 12, vaddw_u16(vld1q_u32(target + 12), vget_high_u16(high)));
+        }
+        accumulateScalar(bytes + i, count - i, sums + i);
+    }
+
+    void sumInterleavedNeon(const std::uint8_t* bytes,
+                            std::size_t count,
+                            std::size_t components,
+                            std::uint32_t* sums) {
+        uint32x4_t accumulators[12];
+        for (auto& accumulator : accumulators) {
+            accumulator = vdupq_n_u32(0);
+        }
+
+        std::size_t i{0};
+        for (; i + INTERLEAVED_BLOCK <= count; i += INTERLEAVED_BLOCK) {
+            for (std::size_t part = 0; part < 3; ++part) {
+                const auto block = vld1q_u8(bytes + i + part * 16);
+                const auto low = vmovl_u8(vget_low_u8(block));
+                const auto high = vmovl_u8(vget_high_u8(block));
+                auto* accumulator = accumulators + part * 4;
+                accumulator[0] = vaddw_u16(accumulator[0], vget_low_u16(low));
+                accumulator[1] = vaddw_u16(accumulator[1], vget_high_u16(low));
+                accumulator[2] = vaddw_u16(accumulator[2], vget_low_u16(high));
+                accumulator[3] = vaddw_u16(accumulator[3], vget_high_u16(high));
+            }
+        }
+
+        std::uint32_t lanes[INTERLEAVED_BLOCK];
+        for (std::size_t accumulator = 0; accumulator < 12; ++accumulator) {
+            vst1q_u32(lanes + accumulator * 4, accumulators[accumulator]);
+        }
+        sumLanes(lanes, components, sums);
+        sumInterleavedTail(bytes, i, count, components, sums);
+    }
+
+    int16x8_t smoothStep(uint8x8_t bytes, int16x8_t weights, std::int16_t* state) {
+        auto current = vld1q_s16(state);
+        const auto delta = vsubq_s16(vreinterpretq_s16_u16(vshll_n_u8(bytes, SMOOTH_SHIFT)), current);
+        current = vaddq_s16(current, vqrdmulhq_s16(delta, weights));
+        vst1q_s16(state, current);
+        return current;
+    }
+
+    void smoothNeon(const std::uint8_t* bytes,
+                    std::size_t count,
+                    std::int16_t weight,
+                    std::int16_t* state,
+                    std::uint8_t* smoothed) {
+        const auto weights = vdupq_n_s16(weight);
+        std::size_t i{0};
+        for (; i + 16 <= count; i += 16) {
+            const auto block = vld1q_u8(bytes + i);
+            const auto low = smoothStep(vget_low_u8(block), weights, state + i);
+            const auto high = smoothStep(vget_high_u8(block), weights, state + i + 8);
+            vst1q_u8(smoothed + i, vcombine_u8(vqrshrun_n_s16(low, SMOOTH_SHIFT), vqrshrun_n_s16(high, SMOOTH_SHIFT)));
+        }
+        smoothScalar(bytes + i, count - i, weight, state + i, smoothed + i);
+    }
+
+    constexpr PixelKernels NEON_KERNELS{"neon", accumulateNeon, sumInterleavedNeon, smoothNeon};
+
+    bool neonSupported() {
+#if defined(__linux__) && !defined(__aarch64__)
+        return (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#else
+        // NEON is mandatory on AArch64.
+        return true;
+#endif
+    }
+
+#endif
+
+    const PixelKernels& selectPixelKernels() {
+#if defined(ATMO_X86_KERNELS)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return AVX2_KERNELS;
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            return SSE41_KERNELS;
+        }
+#elif defined(ATMO_NEON_KERNELS)
+        if (neonSupported()) {
+            return NEON_KERNELS;
+        }
+#endif
+        return SCALAR_KERNELS;
+    }
+
+}
+
+namespace atmo {
+
+    const PixelKernels& pixelKernels() {
+        static const auto& kernels = []() -> const PixelKernels& {
+            const auto& selected = selectPixelKernels();
+            spdlog::info("Using {} pixel kernels", selected.name);
+            return selected;
+        }();
+        return kernels;
+    }
+
+    std::vector<const PixelKernels*> supportedPixelKernels() {
+        std::vector<const PixelKernels*> kernels{&SCALAR_KERNELS};
+#if defined(ATMO_X86_KERNELS)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.1")) {
+            kernels.push_back(&SSE41_KERNELS);
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            kernels.push_back(&AVX2_KERNELS);
+        }
+#elif defined(ATMO_NEON_KERNELS)
+        if (neonSupported()) {
+            kernels.push_back(&NEON_KERNELS);
+        }
+#endif
+        return kernels;
+    }
+
+}
@@ -4,9 +4,12 @@
 
 #include "request_handler.hpp"
 
+#include <iterator>
+#include <type_traits>
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
 #include <fmt/format.h>
+#include "request_parser.hpp"
 
 namespace {
 
@@ -25,6 +28,25 @@ namespace {
         return getRequiredNode(json_node, property).get<T>();
     }
 
+    auto readColor(const json& json_node) {
+        const auto red = getRequired<std::uint8_t>(json_node, "red");
+        const auto green = getRequired<std::uint8_t>(json_node, "green");
+        const auto blue = getRequired<std::uint8_t>(json_node, "blue");
+        return Color{red, green, blue};
+    }
+
+    auto readChannelColor(const json& json_node) {
+        return ChannelColor{getRequired<Channel>(json_node, "channel"), readColor(json_node)};
+    }
+
+    std::uint16_t readUInt16(gsl::span<const unsigned char> message, std::ptrdiff_t position) {
+        return static_cast<std::uint16_t>((message[position] << 8) | message[position + 1]);
+    }
+
+    // Binary requests reference packed R, G, B bytes as colors without copying them.
+    static_assert(sizeof(Color) == 3 && alignof(Color) == 1, "Color has to be layout compatible to packed RGB bytes");
+    static_assert(std::is_trivially_copyable_v<Color>, "Color has to be layout compatible to packed RGB bytes");
+
     auto modeToString(Mode mode) {
         switch (mode) {
             case Mode::Analyzer:
@@ -45,6 +67,28 @@ namespace {
         return successfulResponse<Response>(msg_id);
     }
 
+    // The channel requests are answered without building a JSON document. The properties are written in the order of
+    // nlohmann::json, so the responses are identical to the ones of Response::toString().
+
+    std::string successfulResponseString(MessageId msg_id) {
+        return fmt::format(R"({{"message":"OK","msg_id":{},"success":true}})", msg_id);
+    }
+
+    std::string channelsResponseString(MessageId msg_id, gsl::span<const Color> channels) {
+        fmt::memory_buffer buffer{};
+        fmt::format_to(std::back_inserter(buffer), R"({{"channels":[)");
+        for (std::ptrdiff_t channel = 0; channel < channels.size(); ++channel) {
+            const auto& color = channels[channel];
+            fmt::format_to(std::back_inserter(buffer), R"({}{{"blue":{},"green":{},"red":{}}})",
+                           channel > 0 ? "," : "",
+                           static_cast<unsigned int>(color.blue),
+                           static_cast<unsigned int>(color.green),
+                           static_cast<unsigned int>(color.red));
+        }
+        fmt::format_to(std::back_inserter(buffer), R"(],"message":"OK","msg_id":{},"success":true}})", msg_id);
+        return fmt::to_string(buffer);
+    }
+
 }
 
 namespace atmo {
@@ -66,23 +110,81 @@ namespace atmo {
         }
     }
 
-    RequestHandler::RequestHandler(Devices& devices, ModeCallbacks mode_callbacks) :
+    RequestHandler::RequestHandler(Devices& devices, ModeCallbacks mode_callbacks, ChannelPublisher* publisher) :
             m_devices{&devices},
-            m_mode_callbacks{std::move(mode_callbacks)} {}
+            m_mode_callbacks{std::move(mode_callbacks)},
+            m_publisher{publisher} {}
+
+    std::optional<std::string> RequestHandler::handleRequest(const std::string& request_json,
+                                                             const std::shared_ptr<Subscriber>& subscriber) {
+        // The frequent channel requests are decoded without building a JSON document. The parser reuses its buffers,
+        // so every thread handling requests has its own.
+        thread_local RequestParser parser{};
+        if (parser.parse(request_json)) {
+            return handleChannelsRequest(parser);
+        }
 
-    std::string RequestHandler::handleRequest(const std::string& request_json) {
         MessageId msg_id{-1};
         try {
             const Request request{request_json};
             msg_id = request.msgId();
-            const auto response = onRequest(request);
+            const auto ack = request.ack();
+            const auto response = onRequest(request, subscriber);
+            if (!ack) {
+                return {};
+            }
             return response.toString();
         } catch (const RequestError& e) {
             spdlog::error("Error while executing request: {}", e.what());
             return Response{msg_id, false, e.what()}.toString();
+        } catch (const std::exception& e) {
+            // Malformed 'msg_id' or 'ack' properties.
+            spdlog::error("Error while executing request: {}", e.what());
+            return Response{msg_id, false, fmt::format("Request failed: {}", e.what())}.toString();
         }
     }
 
+    std::optional<std::string> RequestHandler::handleBinaryRequest(gsl::span<const unsigned char> request) {
+        try {
+            const SetChannelsBinaryRequest set_channels_request{request};
+            m_devices->setChannels(set_channels_request.device(),
+                                   set_channels_request.first(),
+                                   set_channels_request.channels());
+            return {};
+        } catch (const std::exception& e) {
+            spdlog::error("Error while executing binary request: {}", e.what());
+            return Response{-1, false, fmt::format("Request failed: {}", e.what())}.toString();
+        }
+    }
+
+    std::optional<std::string> RequestHandler::handleChannelsRequest(const RequestParser& request) {
+        try {
+            switch (request.command()) {
+                case RequestParser::Command::SetChannel:
+                    m_devices->setChannelColors(request.device(), request.channelColors());
+                    break;
+                case RequestParser::Command::SetChannels:
+                    m_devices->setChannels(request.device(), request.colors());
+                    break;
+                case RequestParser::Command::GetChannels: {
+                    const auto channels = m_devices->getChannels(request.device());
+                    if (!request.ack()) {
+                        return {};
+                    }
+                    return channelsResponseString(request.msgId(), channels);
+                }
+            }
+        } catch (const std::exception& e) {
+            const RequestError error{fmt::format("Request failed: {}", e.what())};
+            spdlog::error("Error while executing request: {}", error.what());
+            return Response{request.msgId(), false, error.what()}.toString();
+        }
+        if (!request.ack()) {
+            return {};
+        }
+        return successfulResponseString(request.msgId());
+    }
+
     Response RequestHandler::onGetModes(const Request& request) const {
         const auto modes = m_mode_callbacks.get_modes_callback();
         return successfulResponse<GetModesResponse>(request.msgId()).modes(modes);
@@ -118,9 +220,9 @@ namespace atmo {
 
     Response RequestHandler::onSetChannel(const Request& request) const {
         SetChannelRequest set_channel_request{request};
-        m_devices->setChannel(set_channel_request.device(),
-                              set_channel_request.channel(),
-                              set_channel_request.color());
+        const auto channel_colors = set_channel_request.channelColors();
+        m_devices->setChannelColors(set_channel_request.device(),
+                                    channel_colors);
         return successfulResponse(request.msgId());
     }
 
@@ -132,7 +234,25 @@ namespace atmo {
         return successfulResponse(request.msgId());
     }
 
-    Response RequestHandler::onRequest(const Request& request) {
+    Response RequestHandler::onSubscribe(const Request& request, const std::shared_ptr<Subscriber>& subscriber) const {
+        if (!m_publisher || !subscriber) {
+            throw RequestError{"Subscriptions are not supported"};
+        }
+        SubscribeRequest subscribe_request{request};
+        m_publisher->subscribe(subscriber, subscribe_request.subscription());
+        return successfulResponse(request.msgId());
+    }
+
+    Response RequestHandler::onUnsubscribe(const Request& request,
+                                           const std::shared_ptr<Subscriber>& subscriber) const {
+        if (!m_publisher || !subscriber) {
+            throw RequestError{"Subscriptions are not supported"};
+        }
+        m_publisher->unsubscribe(subscriber.get());
+        return successfulResponse(request.msgId());
+    }
+
+    Response RequestHandler::onRequest(const Request& request, const std::shared_ptr<Subscriber>& subscriber) {
         try {
             if (request.cmd() == "set_channel") {
                 return onSetChannel(request);
@@ -150,6 +270,10 @@ namespace atmo {
                 return onGetMode(request);
             } else if (request.cmd() == "set_mode") {
                 return onSetMode(request);
+            } else if (request.cmd() == "subscribe") {
+                return onSubscribe(request, subscriber);
+            } else if (request.cmd() == "unsubscribe") {
+                return onUnsubscribe(request, subscriber);
             } else {
                 throw RequestError{fmt::format("Illegal command: '{}'", request.cmd())};
             }
@@ -168,6 +292,13 @@ namespace atmo {
         return getRequired<MessageId>(m_json, "msg_id");
     }
 
+    bool Request::ack() const {
+        if (!m_json.contains("ack")) {
+            return true;
+        }
+        return getRequired<bool>(m_json, "ack");
+    }
+
     Mode SetModeRequest::mode() const {
         const auto mode = getRequired<std::string>(m_json, "mode");
         if (mode == "analyzer") {
@@ -179,6 +310,21 @@ namespace atmo {
         }
     }
 
+    Subscription SubscribeRequest::subscription() const {
+        Subscription subscription{};
+        if (m_json.contains("devices")) {
+            const auto devices_node = getRequiredNode(m_json, "devices");
+            if (!devices_node.is_array()) {
+                throw std::runtime_error{"Expected property 'devices' to be an array element"};
+            }
+            subscription.devices = devices_node.get<std::vector<DeviceIndex>>();
+        }
+        if (m_json.contains("delta")) {
+            subscription.delta = getRequired<bool>(m_json, "delta");
+        }
+        return subscription;
+    }
+
     DeviceIndex GetChannelRequest::device() const {
         return getRequired<DeviceIndex>(m_json, "device");
     }
@@ -195,15 +341,20 @@ namespace atmo {
         return getRequired<DeviceIndex>(m_json, "device");
     }
 
-    Channel SetChannelRequest::channel() const {
-        return getRequired<Channel>(m_json, "channel");
-    }
-
-    Color SetChannelRequest::color() const {
-        const auto red = getRequired<std::uint8_t>(m_json, "red");
-        const auto green = getRequired<std::uint8_t>(m_json, "green");
-        const auto blue = getRequired<std::uint8_t>(m_json, "blue");
-        return Color{red, green, blue};
+    std::vector<ChannelColor> SetChannelRequest::channelColors() const {
+        if (!m_json.contains("channels")) {
+            return {readChannelColor(m_json)};
+        }
+        const auto channels_node = getRequiredNode(m_json, "channels");
+        if (!channels_node.is_array()) {
+            throw std::runtime_error{"Expected property 'channels' to be an array element"};
+        }
+        std::vector<ChannelColor> channel_colors{};
+        channel_colors.reserve(channels_node.size());
+        for (const auto& el : channels_node.items()) {
+            channel_colors.push_back(readChannelColor(el.value()));
+        }
+        return channel_colors;
     }
 
     DeviceIndex SetChannelsRequest::device() const {
@@ -218,15 +369,39 @@ namespace atmo {
         std::vector<Color> channels{};
         channels.reserve(channels_node.size());
         for (const auto& el : channels_node.items()) {
-            const auto value = el.value();
-            const auto red = getRequired<std::uint8_t>(value, "red");
-            const auto green = getRequired<std::uint8_t>(value, "green");
-            const auto blue = getRequired<std::uint8_t>(value, "blue");
-            channels.emplace_back(red, green, blue);
+            channels.push_back(readColor(el.value()));
         }
         return channels;
     }
 
+    SetChannelsBinaryRequest::SetChannelsBinaryRequest(gsl::span<const unsigned char> message) :
+            m_message{message} {
+        if (m_message.size() < static_cast<std::ptrdiff_t>(HEADER_LENGTH)) {
+            throw RequestError{fmt::format("Binary request too short: {} bytes", m_message.size())};
+        }
+        if (m_message[0] != TYPE) {
+            throw RequestError{fmt::format("Illegal binary request type: {}", m_message[0])};
+        }
+        const auto length = static_cast<std::ptrdiff_t>(HEADER_LENGTH + readUInt16(m_message, 5) * 3);
+        if (m_message.size() != length) {
+            throw RequestError{fmt::format("Invalid binary request length: expected {} bytes but got {}",
+                                           length, m_message.size())};
+        }
+    }
+
+    DeviceIndex SetChannelsBinaryRequest::device() const {
+        return readUInt16(m_message, 1);
+    }
+
+    Channel SetChannelsBinaryRequest::first() const {
+        return readUInt16(m_message, 3);
+    }
+
+    gsl::span<const Color> SetChannelsBinaryRequest::channels() const {
+        const auto* colors = reinterpret_cast<const Color*>(m_message.data() + HEADER_LENGTH);
+        return {colors, readUInt16(m_message, 5)};
+    }
+
     Response::Response(MessageId msg_id, bool success, std::string message) :
             m_json{} {
         m_json["msg_id"] = msg_id;
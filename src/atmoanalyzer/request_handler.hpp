@@ -4,15 +4,20 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
+#include <gsl/span>
 #include <nlohmann/json.hpp>
 #include <atmo/devices.hpp>
 #include <atmo/mode.hpp>
+#include "channel_publisher.hpp"
 
 namespace atmo {
 
     using MessageId = std::int32_t;
 
+    class RequestParser;
+
     /**
      * Basic request parent class. A request consists of a JSON body that has at least the 'cmd' field.
      */
@@ -34,6 +39,14 @@ namespace atmo {
          */
         MessageId msgId() const;
 
+        /**
+         * Return whether the request is answered if it succeeds. Clients streaming colors can set 'ack' to false, so
+         * they do not have to read a response for each request. Failed requests are always answered.
+         *
+         * @return false if successful requests must not be answered
+         */
+        bool ack() const;
+
     protected:
         nlohmann::json m_json;
     };
@@ -87,7 +100,8 @@ namespace atmo {
     };
 
     /**
-     * Change the current color of a specific device channel.
+     * Change the current color of a specific device channel. Instead of a single channel, the request may contain a
+     * 'channels' array of channel indices and colors, which are changed with a single device update.
      */
     class SetChannelRequest : public Request {
     public:
@@ -99,18 +113,11 @@ namespace atmo {
         DeviceIndex device() const;
 
         /**
-         * The channel to change.
+         * The channels to change and their new colors.
          *
-         * @return the index of the channel
+         * @return the list of channel colors
          */
-        Channel channel() const;
-
-        /**
-         * The new color.
-         *
-         * @return the color
-         */
-        Color color() const;
+        std::vector<ChannelColor> channelColors() const;
     };
 
     /**
@@ -133,6 +140,70 @@ namespace atmo {
         std::vector<Color> channels() const;
     };
 
+    /**
+     * Subscribe to pushed channel updates of some or all devices. A new subscription replaces the previous one.
+     */
+    class SubscribeRequest : public Request {
+    public:
+        /**
+         * The devices and format of the updates. Without 'devices', all devices are subscribed.
+         *
+         * @return the subscription
+         */
+        Subscription subscription() const;
+    };
+
+    /**
+     * Change the colors of a range of channels of a specific device. This request is sent as binary message instead of
+     * JSON, so high-rate streams do not need to serialize every color. All numbers are unsigned big-endian integers:
+     *
+     * | Offset | Size      | Field                                   |
+     * |--------|-----------|-----------------------------------------|
+     * | 0      | 1         | message type, 0x01 for set channels     |
+     * | 1      | 2         | device index                            |
+     * | 3      | 2         | index of the first channel to set       |
+     * | 5      | 2         | number of channels (count)              |
+     * | 7      | 3 * count | colors of the channels as R, G, B bytes |
+     *
+     * The colors are referenced in place, the message has to outlive the request.
+     */
+    class SetChannelsBinaryRequest {
+    public:
+        static constexpr unsigned char TYPE{0x01};
+        static constexpr std::size_t HEADER_LENGTH{7};
+
+        /**
+         * Constructor. Validates the message header and length.
+         *
+         * @param message the binary message
+         */
+        explicit SetChannelsBinaryRequest(gsl::span<const unsigned char> message);
+
+        /**
+         * The device to change.
+         *
+         * @return the index of the device
+         */
+        DeviceIndex device() const;
+
+        /**
+         * The first channel to change.
+         *
+         * @return the index of the first channel
+         */
+        Channel first() const;
+
+        /**
+         * The new colors of the channels starting at first().
+         *
+         * @return the colors, referencing the message
+         */
+        gsl::span<const Color> channels() const;
+
+    private:
+        gsl::span<const unsigned char> m_message;
+    };
+
     /**
      * Basic response parent class.
      */
@@ -231,21 +302,37 @@ namespace atmo {
          *
          * @param devices the devices manager
          * @param mode_callbacks the callbacks to access the modes
+         * @param publisher the publisher of channel updates or nullptr if subscriptions are not supported
          */
         RequestHandler(Devices& devices,
-                       ModeCallbacks mode_callbacks);
+                       ModeCallbacks mode_callbacks,
+                       ChannelPublisher* publisher = nullptr);
 
         /**
          * Parse the incoming request from the JSON string, execute the command and return the response as JSON string.
          *
          * @param request_json the request body as a JSON string
-         * @return the response body as a JSON string
+         * @param subscriber the sender of the request, which receives the channel updates it subscribes to
+         * @return the response body as a JSON string or empty if the request succeeded and is not acknowledged
          */
-        std::string handleRequest(const std::string& request_json);
+        std::optional<std::string> handleRequest(const std::string& request_json,
+                                                 const std::shared_ptr<Subscriber>& subscriber = {});
+
+        /**
+         * Parse the incoming binary request and execute it. Binary requests are only answered if they fail, so streams
+         * of binary requests do not wait for responses.
+         *
+         * @param request the binary request
+         * @return the error response as JSON string or empty if the request has been executed
+         */
+        std::optional<std::string> handleBinaryRequest(gsl::span<const unsigned char> request);
 
     private:
         Devices* m_devices;
         ModeCallbacks m_mode_callbacks;
+        ChannelPublisher* m_publisher;
+
+        std::optional<std::string> handleChannelsRequest(const RequestParser& request);
 
         Response onGetModes(const Request& request) const;
 
@@ -263,7 +350,11 @@ namespace atmo {
 
         Response onSetChannels(const Request& request) const;
 
-        Response onRequest(const Request& request);
+        Response onSubscribe(const Request& request, const std::shared_ptr<Subscriber>& subscriber) const;
+
+        Response onUnsubscribe(const Request& request, const std::shared_ptr<Subscriber>& subscriber) const;
+
+        Response onRequest(const Request& request, const std::shared_ptr<Subscriber>& subscriber);
     };
 
 }
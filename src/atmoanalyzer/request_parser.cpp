@@ -0,0 +1,325 @@
+//
+// Created by Benedikt on 17.10.2026.
+//
+
+#include "request_parser.hpp"
+
+#include <limits>
+
+namespace {
+
+    using namespace atmo;
+
+    /**
+     * The depth of the request properties, the elements of the 'channels' array and their properties.
+     */
+    constexpr std::size_t REQUEST_DEPTH{1};
+    constexpr std::size_t CHANNELS_DEPTH{2};
+    constexpr std::size_t CHANNEL_DEPTH{3};
+
+    bool complete(const std::optional<Channel>& channel,
+                  const std::optional<std::uint8_t>& red,
+                  const std::optional<std::uint8_t>& green,
+                  const std::optional<std::uint8_t>& blue) {
+        return channel && red && green && blue;
+    }
+
+}
+
+namespace atmo {
+
+    RequestParser::RequestParser() :
+            m_command{},
+            m_msg_id{},
+            m_ack{true},
+            m_device{},
+            m_channel{},
+            m_element{},
+            m_has_channels{false},
+            m_complete_channels{false},
+            m_complete_colors{false},
+            m_colors{},
+            m_channels{},
+            m_channel_colors{},
+            m_depth{0},
+            m_skip_depth{0},
+            m_property{Property::None} {}
+
+    bool RequestParser::parse(const std::string& request_json) {
+        m_command.reset();
+        m_msg_id.reset();
+        m_ack = true;
+        m_device.reset();
+        m_channel = {};
+        m_has_channels = false;
+        m_depth = 0;
+        m_skip_depth = 0;
+        m_property = Property::None;
+
+        if (!nlohmann::json::sax_parse(request_json, this) || !m_command || !m_msg_id || !m_device) {
+            return false;
+        }
+
+        switch (*m_command) {
+            case Command::SetChannel:
+                if (m_has_channels) {
+                    if (!m_complete_channels || !m_complete_colors) {
+                        return false;
+                    }
+                    m_channel_colors.resize(m_colors.size());
+                    for (std::size_t index = 0; index < m_colors.size(); ++index) {
+                        m_channel_colors[index] = ChannelColor{m_channels[index], m_colors[index]};
+                    }
+                    return true;
+                }
+                if (!complete(m_channel.channel, m_channel.red, m_channel.green, m_channel.blue)) {
+                    return false;
+                }
+                m_channel_colors.assign(1, ChannelColor{*m_channel.channel,
+                                                        Color{*m_channel.red, *m_channel.green, *m_channel.blue}});
+                return true;
+            case Command::SetChannels:
+                return m_has_channels && m_complete_colors;
+            case Command::GetChannels:
+                return true;
+        }
+        return false;
+    }
+
+    RequestParser::Command RequestParser::command() const {
+        return *m_command;
+    }
+
+    MessageId RequestParser::msgId() const {
+        return *m_msg_id;
+    }
+
+    bool RequestParser::ack() const {
+        return m_ack;
+    }
+
+    DeviceIndex RequestParser::device() const {
+        return *m_device;
+    }
+
+    gsl::span<const Color> RequestParser::colors() const {
+        return m_colors;
+    }
+
+    gsl::span<const ChannelColor> RequestParser::channelColors() const {
+        return m_channel_colors;
+    }
+
+    bool RequestParser::null() {
+        return skipping() || ignored();
+    }
+
+    bool RequestParser::boolean(bool value) {
+        if (skipping()) {
+            return true;
+        }
+        if (m_depth == REQUEST_DEPTH && m_property == Property::Ack) {
+            m_ack = value;
+            return true;
+        }
+        return ignored();
+    }
+
+    bool RequestParser::number_integer(number_integer_t value) {
+        if (skipping()) {
+            return true;
+        }
+        // Only negative numbers are reported as signed integers.
+        if (m_depth == REQUEST_DEPTH && m_property == Property::MsgId) {
+            if (value < std::numeric_limits<MessageId>::min()) {
+                return false;
+            }
+            m_msg_id = static_cast<MessageId>(value);
+            return true;
+        }
+        return ignored();
+    }
+
+    bool RequestParser::number_unsigned(number_unsigned_t value) {
+        if (skipping()) {
+            return true;
+        }
+        if (m_depth == CHANNEL_DEPTH) {
+            return setChannelProperty(m_element, value);
+        }
+        if (m_depth != REQUEST_DEPTH) {
+            return false;
+        }
+        switch (m_property) {
+            case Property::MsgId:
+                if (value > static_cast<number_unsigned_t>(std::numeric_limits<MessageId>::max())) {
+                    return false;
+                }
+                m_msg_id = static_cast<MessageId>(value);
+                return true;
+            case Property::Device:
+                m_device = static_cast<DeviceIndex>(value);
+                return true;
+            default:
+                return setChannelProperty(m_channel, value);
+        }
+    }
+
+    bool RequestParser::number_float(number_float_t, const string_t&) {
+        return skipping() || ignored();
+    }
+
+    bool RequestParser::string(string_t& value) {
+        if (skipping()) {
+            return true;
+        }
+        if (m_depth == REQUEST_DEPTH && m_property == Property::Cmd) {
+            if (value == "set_channel") {
+                m_command = Command::SetChannel;
+            } else if (value == "set_channels") {
+                m_command = Command::SetChannels;
+            } else if (value == "get_channels") {
+                m_command = Command::GetChannels;
+            } else {
+                return false;
+            }
+            return true;
+        }
+        return ignored();
+    }
+
+    bool RequestParser::binary(binary_t&) {
+        return skipping() || ignored();
+    }
+
+    bool RequestParser::start_object(std::size_t) {
+        if (skipping()) {
+            ++m_depth;
+            return true;
+        }
+        if (m_depth == 0 || m_depth == CHANNELS_DEPTH) {
+            m_element = {};
+            ++m_depth;
+            return true;
+        }
+        return ignored() && skip();
+    }
+
+    bool RequestParser::key(string_t& value) {
+        if (skipping()) {
+            return true;
+        }
+        if (value == "channel") {
+            m_property = Property::Channel;
+        } else if (value == "red") {
+            m_property = Property::Red;
+        } else if (value == "green") {
+            m_property = Property::Green;
+        } else if (value == "blue") {
+            m_property = Property::Blue;
+        } else if (m_depth != REQUEST_DEPTH) {
+            m_property = Property::Other;
+        } else if (value == "cmd") {
+            m_property = Property::Cmd;
+        } else if (value == "msg_id") {
+            m_property = Property::MsgId;
+        } else if (value == "ack") {
+            m_property = Property::Ack;
+        } else if (value == "device") {
+            m_property = Property::Device;
+        } else if (value == "channels") {
+            m_property = Property::Channels;
+        } else {
+            m_property = Property::Other;
+        }
+        return true;
+    }
+
+    bool RequestParser::end_object() {
+        if (m_depth == m_skip_depth) {
+            m_skip_depth = 0;
+        } else if (!skipping() && m_depth == CHANNEL_DEPTH) {
+            m_complete_channels = m_complete_channels && m_element.channel;
+            m_complete_colors = m_complete_colors && m_element.red && m_element.green && m_element.blue;
+            m_channels.push_back(m_element.channel.value_or(0));
+            m_colors.push_back(Color{m_element.red.value_or(0),
+                                     m_element.green.value_or(0),
+                                     m_element.blue.value_or(0)});
+        }
+        --m_depth;
+        return true;
+    }
+
+    bool RequestParser::start_array(std::size_t elements) {
+        if (skipping()) {
+            ++m_depth;
+            return true;
+        }
+        if (m_depth == REQUEST_DEPTH && m_property == Property::Channels) {
+            // A repeated property replaces the previous value, like in the JSON document.
+            m_has_channels = true;
+            m_complete_channels = true;
+            m_complete_colors = true;
+            m_colors.clear();
+            m_channels.clear();
+            if (elements != std::numeric_limits<std::size_t>::max()) {
+                m_colors.reserve(elements);
+                m_channels.reserve(elements);
+            }
+            ++m_depth;
+            return true;
+        }
+        return ignored() && skip();
+    }
+
+    bool RequestParser::end_array() {
+        if (m_depth == m_skip_depth) {
+            m_skip_depth = 0;
+        }
+        --m_depth;
+        return true;
+    }
+
+    bool RequestParser::parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) {
+        return false;
+    }
+
+    bool RequestParser::skipping() const {
+        return m_skip_depth > 0;
+    }
+
+    bool RequestParser::ignored() const {
+        return (m_depth == REQUEST_DEPTH || m_depth == CHANNEL_DEPTH) && m_property == Property::Other;
+    }
+
+    bool RequestParser::skip() {
+        ++m_depth;
+        m_skip_depth = m_depth;
+        return true;
+    }
+
+    bool RequestParser::setChannelProperty(ChannelProperties& properties, number_unsigned_t value) const {
+        const auto color_value = [value](std::optional<std::uint8_t>& color) {
+            if (value > std::numeric_limits<std::uint8_t>::max()) {
+                return false;
+            }
+            color = static_cast<std::uint8_t>(value);
+            return true;
+        };
+
+        switch (m_property) {
+            case Property::Channel:
+                properties.channel = static_cast<Channel>(value);
+                return true;
+            case Property::Red:
+                return color_value(properties.red);
+            case Property::Green:
+                return color_value(properties.green);
+            case Property::Blue:
+                return color_value(properties.blue);
+            default:
+                return ignored();
+        }
+    }
+
+}
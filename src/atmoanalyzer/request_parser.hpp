@@ -0,0 +1,181 @@
+//
+// Created by Benedikt on 17.10.2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <gsl/span>
+#include <nlohmann/json.hpp>
+#include "request_handler.hpp"
+
+namespace atmo {
+
+    /**
+     * The RequestParser decodes the frequent channel requests 'set_channel', 'set_channels' and 'get_channels' with the
+     * SAX interface of nlohmann::json instead of building a JSON document. The colors are decoded straight into
+     * buffers, which are reused by the following requests of the same parser.
+     *
+     * Only complete and well-typed requests are decoded. Anything else, e.g. other commands, missing properties or
+     * colors out of range, is rejected, so the generic Request classes handle it and report the same errors as before.
+     */
+    class RequestParser final : public nlohmann::json_sax<nlohmann::json> {
+    public:
+        enum class Command {
+            SetChannel,
+            SetChannels,
+            GetChannels
+        };
+
+        RequestParser();
+
+        /**
+         * Parse the given request.
+         *
+         * @param request_json the request body as a JSON string
+         * @return true if the request has been decoded, false if it has to be handled by the generic Request classes
+         */
+        bool parse(const std::string& request_json);
+
+        /**
+         * The decoded command.
+         *
+         * @return the command
+         */
+        [[nodiscard]]
+        Command command() const;
+
+        /**
+         * The request message id.
+         *
+         * @return the message id
+         */
+        [[nodiscard]]
+        MessageId msgId() const;
+
+        /**
+         * Whether the request is answered if it succeeds, see Request::ack().
+         *
+         * @return false if successful requests must not be answered
+         */
+        [[nodiscard]]
+        bool ack() const;
+
+        /**
+         * The device to change or query.
+         *
+         * @return the index of the device
+         */
+        [[nodiscard]]
+        DeviceIndex device() const;
+
+        /**
+         * The channels of a 'set_channels' request.
+         *
+         * @return the colors, referencing the buffer of the parser
+         */
+        [[nodiscard]]
+        gsl::span<const Color> colors() const;
+
+        /**
+         * The channels and colors of a 'set_channel' request.
+         *
+         * @return the channel colors, referencing the buffer of the parser
+         */
+        [[nodiscard]]
+        gsl::span<const ChannelColor> channelColors() const;
+
+        bool null() override;
+
+        bool boolean(bool value) override;
+
+        bool number_integer(number_integer_t value) override;
+
+        bool number_unsigned(number_unsigned_t value) override;
+
+        bool number_float(number_float_t value, const string_t& string) override;
+
+        bool string(string_t& value) override;
+
+        bool binary(binary_t& value) override;
+
+        bool start_object(std::size_t elements) override;
+
+        bool key(string_t& value) override;
+
+        bool end_object() override;
+
+        bool start_array(std::size_t elements) override;
+
+        bool end_array() override;
+
+        bool parse_error(std::size_t position,
+                         const std::string& last_token,
+                         const nlohmann::detail::exception& exception) override;
+
+    private:
+        enum class Property {
+            None,
+            Cmd,
+            MsgId,
+            Ack,
+            Device,
+            Channel,
+            Red,
+            Green,
+            Blue,
+            Channels,
+            Other
+        };
+
+        /**
+         * A channel and its color, either the top-level properties or an element of the 'channels' array.
+         */
+        struct ChannelProperties {
+            std::optional<Channel> channel;
+            std::optional<std::uint8_t> red;
+            std::optional<std::uint8_t> green;
+            std::optional<std::uint8_t> blue;
+        };
+
+        std::optional<Command> m_command;
+        std::optional<MessageId> m_msg_id;
+        bool m_ack;
+        std::optional<DeviceIndex> m_device;
+        ChannelProperties m_channel;
+        ChannelProperties m_element;
+        bool m_has_channels;
+        bool m_complete_channels;
+        bool m_complete_colors;
+        std::vector<Color> m_colors;
+        std::vector<Channel> m_channels;
+        std::vector<ChannelColor> m_channel_colors;
+        std::size_t m_depth;
+        std::size_t m_skip_depth;
+        Property m_property;
+
+        /**
+         * Return whether the parser is inside a value of an unknown property, which is skipped.
+         */
+        [[nodiscard]]
+        bool skipping() const;
+
+        /**
+         * Return whether the current value belongs to an unknown property and can be ignored. Values of known
+         * properties with an unexpected type reject the request.
+         */
+        [[nodiscard]]
+        bool ignored() const;
+
+        /**
+         * Skip the object or array that has been started for an unknown property.
+         */
+        bool skip();
+
+        bool setChannelProperty(ChannelProperties& properties, number_unsigned_t value) const;
+    };
+
+}
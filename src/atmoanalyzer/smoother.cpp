@@ -0,0 +1,79 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <atmo/smoother.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+    constexpr int STATE_SHIFT{7};
+    constexpr double MAX_WEIGHT{32767.0};
+
+    /**
+     * The weight that moves the state by one output step (1 << STATE_SHIFT) for a difference of one step. With smaller
+     * weights, the rounded update becomes zero before the output reaches its target, or the state does not move at
+     * all.
+     */
+    constexpr double MIN_WEIGHT{MAX_WEIGHT / (1 << STATE_SHIFT)};
+
+    static_assert(sizeof(atmo::Color) == 3, "Channels are smoothed as contiguous bytes");
+
+}
+
+namespace atmo {
+
+    Smoother::Smoother(const SmoothingConfig& config) :
+            m_config{config},
+            m_kernels{&pixelKernels()},
+            m_state{},
+            m_last_time{} {}
+
+    bool Smoother::enabled() const {
+        return m_config.time_constant.count() > 0;
+    }
+
+    void Smoother::apply(gsl::span<Color> channels, Clock::time_point time) {
+        if (!enabled()) {
+            return;
+        }
+
+        const gsl::span<std::uint8_t> bytes{reinterpret_cast<std::uint8_t*>(channels.data()),
+                                            channels.size() * static_cast<std::ptrdiff_t>(sizeof(Color))};
+        const auto last_time = m_last_time;
+        m_last_time = time;
+        if (!last_time || m_state.size() != static_cast<std::size_t>(bytes.size()) || sceneCut(bytes)) {
+            reset(bytes);
+            return;
+        }
+
+        const std::chrono::duration<double> interval = std::max(time - *last_time, Clock::duration::zero());
+        const std::chrono::duration<double> time_constant = m_config.time_constant;
+        const auto alpha = 1.0 - std::exp(-interval.count() / time_constant.count());
+        const auto weight = static_cast<std::int16_t>(std::lround(std::clamp(alpha * MAX_WEIGHT,
+                                                                             MIN_WEIGHT,
+                                                                             MAX_WEIGHT)));
+        m_kernels->smooth(bytes.data(), bytes.size(), weight, m_state.data(), bytes.data());
+    }
+
+    bool Smoother::sceneCut(gsl::span<const std::uint8_t> bytes) const {
+        if (m_config.scene_cut_threshold == 0 || bytes.empty()) {
+            return false;
+        }
+        std::int64_t difference{0};
+        for (std::ptrdiff_t i = 0; i < bytes.size(); ++i) {
+            difference += std::abs((bytes[i] << STATE_SHIFT) - m_state[i]);
+        }
+        return difference > (static_cast<std::int64_t>(m_config.scene_cut_threshold) << STATE_SHIFT) * bytes.size();
+    }
+
+    void Smoother::reset(gsl::span<const std::uint8_t> bytes) {
+        m_state.resize(bytes.size());
+        std::transform(std::begin(bytes), std::end(bytes), std::begin(m_state),
+                       [](std::uint8_t byte) { return static_cast<std::int16_t>(byte << STATE_SHIFT); });
+    }
+
+}
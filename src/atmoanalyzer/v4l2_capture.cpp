@@ -0,0 +1,321 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#ifdef WITH_V4L2
+
+#include <atmo/v4l2_capture.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/videodev2.h>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+    using namespace atmo;
+
+    constexpr std::uint32_t BUFFER_COUNT{4};
+    constexpr int POLL_TIMEOUT_MS{1000};
+
+    void ioError(const std::string& error_message) {
+        const auto error = errno;
+        throw std::runtime_error{fmt::format("{}: {} {}",
+                                             error_message, error, std::strerror(error))};
+    }
+
+    /**
+     * Calls a function when leaving the scope, unless it has been dismissed before.
+     */
+    template<class Function>
+    class ScopeGuard {
+    public:
+        explicit ScopeGuard(Function function) :
+                m_function{std::move(function)},
+                m_active{true} {}
+
+        ~ScopeGuard() {
+            if (m_active) {
+                m_function();
+            }
+        }
+
+        ScopeGuard(const ScopeGuard&) = delete;
+
+        ScopeGuard& operator=(const ScopeGuard&) = delete;
+
+        void dismiss() {
+            m_active = false;
+        }
+
+    private:
+        Function m_function;
+        bool m_active;
+    };
+
+    int xioctl(int file_descriptor, unsigned long request, void* argument) {
+        int result{0};
+        do {
+            result = ioctl(file_descriptor, request, argument);
+        } while (result < 0 && errno == EINTR);
+        return result;
+    }
+
+    std::uint32_t fourcc(PixelFormat pixel_format) {
+        switch (pixel_format) {
+            case PixelFormat::YUYV:
+                return V4L2_PIX_FMT_YUYV;
+            case PixelFormat::NV12:
+                return V4L2_PIX_FMT_NV12;
+            case PixelFormat::RGB:
+                return V4L2_PIX_FMT_RGB24;
+            case PixelFormat::BGR:
+                return V4L2_PIX_FMT_BGR24;
+            default:
+                throw std::runtime_error{fmt::format("V4L2: Unsupported pixel format {}", pixel_format)};
+        }
+    }
+
+    std::size_t frameSize(const ImageView& image) {
+        const auto size = image.stride * static_cast<std::size_t>(image.height);
+        if (image.format == PixelFormat::NV12) {
+            return size + image.chroma_stride * static_cast<std::size_t>((image.height + 1) / 2);
+        }
+        return size;
+    }
+
+}
+
+namespace atmo {
+
+    V4L2Capture::V4L2Capture(const std::string& filename, const Format& format, ChannelConfigs channel_configs) :
+            m_filename{filename},
+            m_file_descriptor{-1},
+            m_border_analyzer{channel_configs},
+            m_image{},
+            m_buffers{},
+            m_streaming{false} {
+        try {
+            m_file_descriptor = open(m_filename.c_str(), O_RDWR | O_NONBLOCK);
+            if (m_file_descriptor < 0) {
+                ioError(fmt::format("V4L2: Could not open capture device '{}'", m_filename));
+            }
+
+            v4l2_capability capability{};
+            if (xioctl(m_file_descriptor, VIDIOC_QUERYCAP, &capability) < 0) {
+                ioError(fmt::format("V4L2: '{}' is no V4L2 device", m_filename));
+            }
+            const auto capabilities = (capability.capabilities & V4L2_CAP_DEVICE_CAPS)
+                                      ? capability.device_caps
+                                      : capability.capabilities;
+            if (!(capabilities & V4L2_CAP_VIDEO_CAPTURE) || !(capabilities & V4L2_CAP_STREAMING)) {
+                throw std::runtime_error{fmt::format(
+                        "V4L2: '{}' does not support single-planar video capture streaming", m_filename)};
+            }
+
+            configureFormat(format);
+            mapBuffers();
+            for (std::uint32_t index = 0; index < m_buffers.size(); ++index) {
+                queueBuffer(index);
+            }
+
+            auto type = static_cast<int>(V4L2_BUF_TYPE_VIDEO_CAPTURE);
+            if (xioctl(m_file_descriptor, VIDIOC_STREAMON, &type) < 0) {
+                ioError("V4L2: Could not start streaming");
+            }
+            m_streaming = true;
+        } catch (...) {
+            closeDevice();
+            throw;
+        }
+    }
+
+    V4L2Capture::V4L2Capture(const ImageView& format, std::vector<Buffer> buffers, ChannelConfigs channel_configs) :
+            m_filename{},
+            m_file_descriptor{-1},
+            m_border_analyzer{channel_configs},
+            m_image{format},
+            m_buffers{std::move(buffers)},
+            m_streaming{false} {
+        m_image.data = nullptr;
+        m_image.chroma = nullptr;
+    }
+
+    V4L2Capture::~V4L2Capture() {
+        closeDevice();
+    }
+
+    void V4L2Capture::configureFormat(const Format& format) {
+        v4l2_format current{};
+        current.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (xioctl(m_file_descriptor, VIDIOC_G_FMT, &current) < 0) {
+            ioError("V4L2: Could not query the capture format");
+        }
+        if (format.width) {
+            current.fmt.pix.width = static_cast<std::uint32_t>(*format.width);
+        }
+        if (format.height) {
+            current.fmt.pix.height = static_cast<std::uint32_t>(*format.height);
+        }
+        current.fmt.pix.field = V4L2_FIELD_NONE;
+
+        const auto candidates = format.pixel_format
+                                ? std::vector<PixelFormat>{*format.pixel_format}
+                                : std::vector<PixelFormat>{PixelFormat::YUYV, PixelFormat::NV12};
+        std::optional<PixelFormat> pixel_format{};
+        for (const auto candidate : candidates) {
+            auto requested = current;
+            requested.fmt.pix.pixelformat = fourcc(candidate);
+            if (xioctl(m_file_descriptor, VIDIOC_S_FMT, &requested) < 0) {
+                ioError("V4L2: Could not set the capture format");
+            }
+            // The driver replaces unsupported formats with a supported one.
+            if (requested.fmt.pix.pixelformat == fourcc(candidate)) {
+                current = requested;
+                pixel_format = candidate;
+                break;
+            }
+        }
+        if (!pixel_format) {
+            throw std::runtime_error{fmt::format("V4L2: '{}' supports none of the requested pixel formats",
+                                                 m_filename)};
+        }
+
+        const auto& pix = current.fmt.pix;
+        m_image.width = static_cast<int>(pix.width);
+        m_image.height = static_cast<int>(pix.height);
+        m_image.format = *pixel_format;
+        m_image.stride = pix.bytesperline;
+        m_image.chroma_stride = pix.bytesperline;
+        spdlog::info("V4L2: Capturing {}x{} frames with pixel format {} from '{}'",
+                     m_image.width, m_image.height,
+                     std::string(reinterpret_cast<const char*>(&pix.pixelformat), sizeof(pix.pixelformat)),
+                     m_filename);
+    }
+
+    void V4L2Capture::mapBuffers() {
+        v4l2_requestbuffers request{};
+        request.count = BUFFER_COUNT;
+        request.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        request.memory = V4L2_MEMORY_MMAP;
+        if (xioctl(m_file_descriptor, VIDIOC_REQBUFS, &request) < 0) {
+            ioError("V4L2: Could not request memory mapped buffers");
+        }
+        if (request.count < 2) {
+            throw std::runtime_error{fmt::format("V4L2: Insufficient buffer memory on '{}'", m_filename)};
+        }
+
+        for (std::uint32_t index = 0; index < request.count; ++index) {
+            v4l2_buffer buffer{};
+            buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buffer.memory = V4L2_MEMORY_MMAP;
+            buffer.index = index;
+            if (xioctl(m_file_descriptor, VIDIOC_QUERYBUF, &buffer) < 0) {
+                ioError("V4L2: Could not query buffer");
+            }
+            auto* data = mmap(nullptr, buffer.length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                              m_file_descriptor, buffer.m.offset);
+            if (data == MAP_FAILED) {
+                ioError("V4L2: Could not map buffer");
+            }
+            m_buffers.push_back(Buffer{data, buffer.length});
+        }
+    }
+
+    void V4L2Capture::queueBuffer(std::uint32_t index) {
+        v4l2_buffer buffer{};
+        buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buffer.memory = V4L2_MEMORY_MMAP;
+        buffer.index = index;
+        if (xioctl(m_file_descriptor, VIDIOC_QBUF, &buffer) < 0) {
+            ioError("V4L2: Could not queue buffer");
+        }
+    }
+
+    std::optional<V4L2Capture::DequeuedBuffer> V4L2Capture::dequeueBuffer() {
+        pollfd poll_descriptor{m_file_descriptor, POLLIN, 0};
+        const auto ready = poll(&poll_descriptor, 1, POLL_TIMEOUT_MS);
+        if (ready < 0 && errno != EINTR) {
+            ioError("V4L2: Could not wait for a frame");
+        }
+        if (ready <= 0) {
+            return std::nullopt;
+        }
+
+        v4l2_buffer buffer{};
+        buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buffer.memory = V4L2_MEMORY_MMAP;
+        if (xioctl(m_file_descriptor, VIDIOC_DQBUF, &buffer) < 0) {
+            if (errno == EAGAIN) {
+                return std::nullopt;
+            }
+            ioError("V4L2: Could not dequeue buffer");
+        }
+        return DequeuedBuffer{buffer.index, buffer.bytesused, (buffer.flags & V4L2_BUF_FLAG_ERROR) != 0};
+    }
+
+    bool V4L2Capture::capture(Channels& channels) {
+        const auto buffer = dequeueBuffer();
+        if (!buffer) {
+            return false;
+        }
+
+        // Hand the buffer back to the driver if the capture fails, otherwise the driver runs out of buffers.
+        ScopeGuard requeue{[this, index = buffer->index]() {
+            try {
+                queueBuffer(index);
+            } catch (const std::exception& e) {
+                spdlog::error("{}", e.what());
+            }
+        }};
+
+        auto image = m_image;
+        image.data = static_cast<const std::uint8_t*>(m_buffers.at(buffer->index).data);
+        if (image.format == PixelFormat::NV12) {
+            image.chroma = image.data + image.stride * static_cast<std::size_t>(image.height);
+        }
+        const auto complete = !buffer->error
+                              && frameSize(image) <= m_buffers[buffer->index].length
+                              && (buffer->bytes_used == 0 || frameSize(image) <= buffer->bytes_used);
+
+        if (complete) {
+            m_border_analyzer.analyze(image, channels);
+        }
+        requeue.dismiss();
+        queueBuffer(buffer->index);
+        return complete;
+    }
+
+    void V4L2Capture::closeDevice() {
+        if (m_streaming) {
+            auto type = static_cast<int>(V4L2_BUF_TYPE_VIDEO_CAPTURE);
+            if (xioctl(m_file_descriptor, VIDIOC_STREAMOFF, &type) < 0) {
+                const auto error = errno;
+                spdlog::error("V4L2: Could not stop streaming: {} {}", error, std::strerror(error));
+            }
+            m_streaming = false;
+        }
+        if (m_file_descriptor > -1) {
+            // Only the buffers of an opened device have been mapped, others are owned by the child class.
+            for (const auto& buffer : m_buffers) {
+                munmap(buffer.data, buffer.length);
+            }
+            if (close(m_file_descriptor) < 0) {
+                const auto error = errno;
+                spdlog::error("V4L2: Could not close capture device: {} {}", error, std::strerror(error));
+            }
+            m_file_descriptor = -1;
+        }
+        m_buffers.clear();
+    }
+
+}
+
+#endif
@@ -11,15 +11,28 @@
 #include <memory>
 #include <fmt/format.h>
 #include <thread>
+#include <vector>
+#include <atmo/network_devices.hpp>
 #include <atmo/serial_devices.hpp>
 #include <atmo/spi_devices.hpp>
+#include <atmo/virtual_devices.hpp>
 
 namespace atmo {
 
     enum class DeviceType {
         AtmoLight,
         KarateLight,
-        DotStar
+        DotStar,
+        APA102,
+        SK9822,
+        WS2801,
+        LPD8806,
+        P9813,
+        DDP,
+        E131,
+        ArtNet,
+        File,
+        Fifo
     };
 
     std::unique_ptr<AtmoDevice> createDevice(DeviceType device_type, const std::string& device) {
@@ -28,9 +41,29 @@ namespace atmo {
                 return std::make_unique<AtmoLight>(device);
             case DeviceType::KarateLight:
                 return std::make_unique<KarateLight>(device);
+            case DeviceType::DDP:
+                return std::make_unique<DDPDevice>(NetworkConfig{device}, 256);
+            case DeviceType::E131:
+                return std::make_unique<E131Device>(NetworkConfig{device}, 256);
+            case DeviceType::ArtNet:
+                return std::make_unique<ArtNetDevice>(NetworkConfig{device}, 256);
+            case DeviceType::File:
+                return std::make_unique<FileDevice>(device, 256, FileType::Regular);
+            case DeviceType::Fifo:
+                return std::make_unique<FileDevice>(device, 256, FileType::Fifo);
 #ifdef WITH_SPI
             case DeviceType::DotStar:
                 return std::make_unique<DotStar>(device, 256);
+            case DeviceType::APA102:
+                return std::make_unique<SPIStrip<APA102Protocol<GlobalBrightness::HighDepth>>>(device, 256);
+            case DeviceType::SK9822:
+                return std::make_unique<SPIStrip<SK9822Protocol<GlobalBrightness::HighDepth>>>(device, 256);
+            case DeviceType::WS2801:
+                return std::make_unique<SPIStrip<WS2801Protocol>>(device, 256);
+            case DeviceType::LPD8806:
+                return std::make_unique<SPIStrip<LPD8806Protocol>>(device, 256);
+            case DeviceType::P9813:
+                return std::make_unique<SPIStrip<P9813Protocol>>(device, 256);
 #endif
             default:
                 throw std::runtime_error{fmt::format("Device type {} is unsupported by this application", device_type)};
@@ -48,12 +81,22 @@ int main(int argc, char** argv) {
     DeviceType device_type{};
     std::map<std::string, DeviceType> map{{"atmolight",   DeviceType::AtmoLight},
                                           {"karatelight", DeviceType::KarateLight},
-                                          {"dotstar", DeviceType::DotStar}};
+                                          {"dotstar", DeviceType::DotStar},
+                                          {"apa102", DeviceType::APA102},
+                                          {"sk9822", DeviceType::SK9822},
+                                          {"ws2801", DeviceType::WS2801},
+                                          {"lpd8806", DeviceType::LPD8806},
+                                          {"p9813", DeviceType::P9813},
+                                          {"ddp", DeviceType::DDP},
+                                          {"e131", DeviceType::E131},
+                                          {"artnet", DeviceType::ArtNet},
+                                          {"file", DeviceType::File},
+                                          {"fifo", DeviceType::Fifo}};
     app.add_option("-t,--type", device_type, "the device type")
             ->required()
             ->transform(CLI::CheckedTransformer(map, CLI::ignore_case));
     std::string device{};
-    app.add_option("-d,--device", device, "the device file to connect to")
+    app.add_option("-d,--device", device, "the device file or network address to connect to")
             ->required();
     int channel_option{-1};
     app.add_option("-c,--channel", channel_option, "the channel");
@@ -68,9 +111,8 @@ int main(int argc, char** argv) {
     atmo_device->clear();
 
     if (channel_option < 0) {
-        for (Channel channel = 0; channel < atmo_device->channels(); ++channel) {
-            atmo_device->setChannel(channel, color);
-        }
+        const std::vector<Color> channels(atmo_device->channels(), color);
+        atmo_device->setChannels(channels);
     } else {
         auto channel = static_cast<Channel>(channel_option);
         atmo_device->setChannel(channel, color);
@@ -0,0 +1,80 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <atmo/color_correction.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <fmt/format.h>
+
+namespace {
+
+    using namespace atmo;
+
+    void checkFactor(const char* name, double factor) {
+        if (!(factor >= 0.0 && factor <= 1.0)) {
+            throw std::runtime_error{fmt::format("Illegal color correction {}: {}", name, factor)};
+        }
+    }
+
+    using LookupTable = std::array<std::uint8_t, 256>;
+
+    LookupTable buildTable(const ColorCorrection& color_correction, double gain) {
+        LookupTable table{};
+        for (std::size_t value = 0; value < table.size(); ++value) {
+            const auto normalized = static_cast<double>(value) / 255.0;
+            const auto corrected = std::pow(normalized, color_correction.gamma) * color_correction.brightness * gain;
+            const auto output = static_cast<std::uint8_t>(std::clamp(std::lround(corrected * 255.0), 0L, 255L));
+            table[value] = output < color_correction.min_threshold ? 0 : output;
+        }
+        return table;
+    }
+
+    bool isIdentity(const LookupTable& table) {
+        for (std::size_t value = 0; value < table.size(); ++value) {
+            if (table[value] != value) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
+
+namespace atmo {
+
+    ColorCorrectionTable::ColorCorrectionTable(const ColorCorrection& color_correction) :
+            m_red{},
+            m_green{},
+            m_blue{},
+            m_identity{false} {
+        if (!(color_correction.gamma > 0.0)) {
+            throw std::runtime_error{fmt::format("Illegal color correction gamma: {}", color_correction.gamma)};
+        }
+        checkFactor("brightness", color_correction.brightness);
+        checkFactor("red gain", color_correction.red);
+        checkFactor("green gain", color_correction.green);
+        checkFactor("blue gain", color_correction.blue);
+
+        m_red = buildTable(color_correction, color_correction.red);
+        m_green = buildTable(color_correction, color_correction.green);
+        m_blue = buildTable(color_correction, color_correction.blue);
+        m_identity = isIdentity(m_red) && isIdentity(m_green) && isIdentity(m_blue);
+    }
+
+    bool ColorCorrectionTable::identity() const {
+        return m_identity;
+    }
+
+    void ColorCorrectionTable::apply(gsl::span<const Color> colors, gsl::span<Color> corrected_colors) const {
+        if (corrected_colors.size() < colors.size()) {
+            throw std::out_of_range{fmt::format("Cannot correct {} colors into {} colors",
+                                                colors.size(), corrected_colors.size())};
+        }
+        std::transform(std::begin(colors), std::end(colors), std::begin(corrected_colors),
+                       [this](Color color) { return (*this)(color); });
+    }
+
+}
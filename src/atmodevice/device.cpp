@@ -5,12 +5,20 @@
 #include <atmo/device.hpp>
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <utility>
 
 namespace atmo {
 
     BaseAtmoDevice::BaseAtmoDevice(std::size_t channels) :
-            m_channels{channels, Color{}} {
+            m_channels{channels, Color{}},
+            m_written_channels{channels, Color{}},
+            m_written{false},
+            m_last_write{},
+            m_update_policy{},
+            m_color_correction{},
+            m_corrected_channels{channels, Color{}} {
         if (channels < 1) {
             throw std::runtime_error{fmt::format("Illegal number of channels: {}", channels)};
         }
@@ -18,7 +26,7 @@ namespace atmo {
 
     void BaseAtmoDevice::clear() {
         std::fill(std::begin(m_channels), std::end(m_channels), Color{});
-        update(m_channels);
+        write(true);
     }
 
     Color BaseAtmoDevice::getChannel(Channel channel) {
@@ -37,7 +45,7 @@ namespace atmo {
             throw std::runtime_error{fmt::format("Invalid channel index: {}", channel)};
         }
         m_channels[channel] = color;
-        update(m_channels);
+        write(false);
     }
 
     void BaseAtmoDevice::setChannels(gsl::span<const Color> channels) {
@@ -47,11 +55,73 @@ namespace atmo {
                                 m_channels.size(), channels.size())};
         }
         std::copy(std::begin(channels), std::end(channels), std::begin(m_channels));
-        update(m_channels);
+        write(false);
+    }
+
+    void BaseAtmoDevice::setChannelRange(Channel first, gsl::span<const Color> channels) {
+        if (first > m_channels.size() || static_cast<std::size_t>(channels.size()) > m_channels.size() - first) {
+            throw std::out_of_range{
+                    fmt::format("Invalid channel range: {} channels available but {} given starting at {}",
+                                m_channels.size(), channels.size(), first)};
+        }
+        std::copy(std::begin(channels), std::end(channels), std::begin(m_channels) + first);
+        write(false);
+    }
+
+    void BaseAtmoDevice::setChannelColors(gsl::span<const ChannelColor> channel_colors) {
+        for (const auto& channel_color : channel_colors) {
+            if (channel_color.channel >= m_channels.size()) {
+                throw std::runtime_error{fmt::format("Invalid channel index: {}", channel_color.channel)};
+            }
+        }
+        for (const auto& channel_color : channel_colors) {
+            m_channels[channel_color.channel] = channel_color.color;
+        }
+        write(false);
     }
 
     std::size_t BaseAtmoDevice::channels() const {
         return m_channels.size();
     }
 
+    void BaseAtmoDevice::setUpdatePolicy(const UpdatePolicy& update_policy) {
+        m_update_policy = update_policy;
+    }
+
+    void BaseAtmoDevice::setColorCorrection(const ColorCorrection& color_correction) {
+        m_color_correction = ColorCorrectionTable{color_correction};
+        m_written = false;
+    }
+
+    bool BaseAtmoDevice::changed() const {
+        const int tolerance = m_update_policy.tolerance;
+        const auto unchanged = [tolerance](const Color& a, const Color& b) {
+            return std::abs(a.red - b.red) <= tolerance
+                   && std::abs(a.green - b.green) <= tolerance
+                   && std::abs(a.blue - b.blue) <= tolerance;
+        };
+        return !std::equal(std::begin(m_channels), std::end(m_channels), std::begin(m_written_channels), unchanged);
+    }
+
+    void BaseAtmoDevice::write(bool force) {
+        const auto now = std::chrono::steady_clock::now();
+        const auto keep_alive = m_update_policy.keep_alive;
+        if (!force && m_update_policy.skip_unchanged && m_written && !changed()
+            && (keep_alive.count() == 0 || now - m_last_write < keep_alive)) {
+            return;
+        }
+
+        // A failed write leaves the device in an unknown state, so the next colors must not be skipped.
+        m_written = false;
+        if (m_color_correction.identity()) {
+            update(m_channels);
+        } else {
+            m_color_correction.apply(m_channels, m_corrected_channels);
+            update(m_corrected_channels);
+        }
+        std::copy(std::begin(m_channels), std::end(m_channels), std::begin(m_written_channels));
+        m_written = true;
+        m_last_write = now;
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <atmo/device_packets.hpp>
+
+#include <algorithm>
+#include <array>
+#include <fmt/format.h>
+
+namespace {
+
+    using namespace atmo;
+
+    constexpr std::array<unsigned char, 7> ATMOLIGHT_HEADER = {
+            0xFF,
+            0x00,
+            0x00,
+            0x0F,
+            0x00,
+            0x00,
+            0x00};
+    constexpr auto ATMOLIGHT_PACKET_SIZE = ATMOLIGHT_HEADER.size() + AtmoLightPacket::CHANNELS * 3;
+    constexpr std::array<unsigned char, 4> KARATELIGHT_HEADER = {
+            0xAA,
+            0x12,
+            0x00,
+            0x30};
+    constexpr auto KARATELIGHT_PACKET_SIZE = 52;
+    constexpr unsigned char KARATELIGHT_CHECKSUM_BYTE_POS = 2;
+
+    void checkChannels(gsl::span<const Color> channels, std::size_t available) {
+        if (channels.size() > static_cast<std::ptrdiff_t>(available)) {
+            throw std::out_of_range{
+                    fmt::format("Invalid number of channels: {} available but {} given", available, channels.size())};
+        }
+    }
+
+}
+
+namespace atmo {
+
+    AtmoLightPacket::AtmoLightPacket() :
+            m_buffer(ATMOLIGHT_PACKET_SIZE) {
+        std::copy(std::begin(ATMOLIGHT_HEADER), std::end(ATMOLIGHT_HEADER), std::begin(m_buffer));
+    }
+
+    gsl::span<const unsigned char> AtmoLightPacket::encode(gsl::span<const Color> channels) {
+        checkChannels(channels, CHANNELS);
+        auto* payload = m_buffer.data() + ATMOLIGHT_HEADER.size();
+        for (const auto color : channels) {
+            *payload++ = color.red;
+            *payload++ = color.green;
+            *payload++ = color.blue;
+        }
+        return m_buffer;
+    }
+
+    KarateLightPacket::KarateLightPacket() :
+            m_buffer(KARATELIGHT_PACKET_SIZE) {
+        std::copy(std::begin(KARATELIGHT_HEADER), std::end(KARATELIGHT_HEADER), std::begin(m_buffer));
+    }
+
+    gsl::span<const unsigned char> KarateLightPacket::encode(gsl::span<const Color> channels) {
+        checkChannels(channels, CHANNELS);
+        auto* payload = m_buffer.data() + KARATELIGHT_HEADER.size();
+        for (const auto color : channels) {
+            *payload++ = color.green;
+            *payload++ = color.blue;
+            *payload++ = color.red;
+        }
+        // The checksum is calculated with the checksum byte set to zero.
+        m_buffer[KARATELIGHT_CHECKSUM_BYTE_POS] = 0;
+        unsigned char checksum{0};
+        for (const auto byte : m_buffer) {
+            checksum ^= byte;
+        }
+        m_buffer[KARATELIGHT_CHECKSUM_BYTE_POS] = checksum;
+        return m_buffer;
+    }
+
+}
@@ -48,4 +48,19 @@ namespace atmo {
      */
     using Channel = std::size_t;
 
+    /**
+     * The new color of one specific channel.
+     */
+    struct ChannelColor {
+        /**
+         * The channel index.
+         */
+        Channel channel;
+
+        /**
+         * The new color.
+         */
+        Color color;
+    };
+
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <gsl/span>
+#include "channel.hpp"
+
+namespace atmo {
+
+    /**
+     * Color correction parameters of one output device. The default values leave all colors unchanged.
+     */
+    struct ColorCorrection {
+        /**
+         * Exponent of the gamma curve applied to each color component (e.g. 2.2 for typical LEDs).
+         */
+        double gamma{1.0};
+
+        /**
+         * Global brightness factor (0...1).
+         */
+        double brightness{1.0};
+
+        /**
+         * Gain of the red component (0...1), used to adjust the white point.
+         */
+        double red{1.0};
+
+        /**
+         * Gain of the green component (0...1), used to adjust the white point.
+         */
+        double green{1.0};
+
+        /**
+         * Gain of the blue component (0...1), used to adjust the white point.
+         */
+        double blue{1.0};
+
+        /**
+         * Corrected color components below this value are turned off, which avoids flickering of very dark LEDs.
+         */
+        std::uint8_t min_threshold{0};
+    };
+
+    /**
+     * Applies a ColorCorrection by one lookup table per color component. The tables are built once, so correcting a
+     * color costs three table lookups.
+     */
+    class ColorCorrectionTable {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param color_correction the correction parameters
+         */
+        explicit ColorCorrectionTable(const ColorCorrection& color_correction = {});
+
+        /**
+         * Return whether the table leaves all colors unchanged.
+         *
+         * @return true if no correction is applied
+         */
+        [[nodiscard]]
+        bool identity() const;
+
+        /**
+         * Return the corrected color.
+         *
+         * @param color the color to correct
+         * @return the corrected color
+         */
+        [[nodiscard]]
+        Color operator()(Color color) const {
+            return Color{m_red[color.red], m_green[color.green], m_blue[color.blue]};
+        }
+
+        /**
+         * Correct all given colors in one pass.
+         *
+         * @param colors the colors to correct
+         * @param corrected_colors the corrected colors, at least as many as colors
+         */
+        void apply(gsl::span<const Color> colors, gsl::span<Color> corrected_colors) const;
+
+    private:
+        using Table = std::array<std::uint8_t, 256>;
+
+        Table m_red;
+        Table m_green;
+        Table m_blue;
+        bool m_identity;
+    };
+
+}
@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <gsl/span>
 #include "channel.hpp"
+#include "color_correction.hpp"
 
 namespace atmo {
 
@@ -56,6 +58,23 @@ namespace atmo {
          */
         virtual void setChannels(gsl::span<const Color> channels) = 0;
 
+        /**
+         * Set a range of consecutive channels to the specified colors. All channels outside of the range keep their
+         * current color.
+         *
+         * @param first the index of the first channel to set
+         * @param channels the colors for the channels starting at first
+         */
+        virtual void setChannelRange(Channel first, gsl::span<const Color> channels) = 0;
+
+        /**
+         * Set several specific channels to the given colors at once. All channels not contained in the list keep their
+         * current color. Unlike multiple calls to setChannel(), the device is only updated once.
+         *
+         * @param channel_colors the channels to change and their new colors
+         */
+        virtual void setChannelColors(gsl::span<const ChannelColor> channel_colors) = 0;
+
         /**
          * Try to reopen the device. This is a workaround for misbehaving USB devices and USB hubs.
          */
@@ -70,12 +89,35 @@ namespace atmo {
         virtual std::size_t channels() const = 0;
     };
 
+    /**
+     * Controls when BaseAtmoDevice writes new colors to the physical device.
+     */
+    struct UpdatePolicy {
+        /**
+         * Skip writes if no channel changed by more than the tolerance since the last successful write.
+         */
+        bool skip_unchanged{true};
+
+        /**
+         * The maximum difference of each color component of a channel that is still considered unchanged.
+         */
+        unsigned char tolerance{0};
+
+        /**
+         * Write unchanged colors anyway once this interval has passed since the last write, so devices with a watchdog
+         * stay lit. Zero disables the keep-alive. The interval is only checked when new colors are set.
+         */
+        std::chrono::milliseconds keep_alive{1000};
+    };
+
     /**
      * Abstract base class that provides a simplified interface and a generic implementation of common behaviour of an
      * AtmoDevice implementation.
      *
      * A child class has to override the protected update() method. This method is called each time one or more channels
-     * are modified.
+     * are modified. Depending on the UpdatePolicy, writes of colors that did not change since the last write are
+     * skipped. The colors passed to update() are corrected by the configured ColorCorrection, while getChannel() and
+     * getChannels() return the uncorrected colors.
      */
     class BaseAtmoDevice : public AtmoDevice {
     public:
@@ -98,9 +140,28 @@ namespace atmo {
 
         void setChannels(gsl::span<const Color> channels) final;
 
+        void setChannelRange(Channel first, gsl::span<const Color> channels) final;
+
+        void setChannelColors(gsl::span<const ChannelColor> channel_colors) final;
+
         [[nodiscard]]
         std::size_t channels() const final;
 
+        /**
+         * Change the policy for skipping unchanged colors.
+         *
+         * @param update_policy the new update policy
+         */
+        void setUpdatePolicy(const UpdatePolicy& update_policy);
+
+        /**
+         * Change the color correction applied to all colors written to the device. The new correction is used by the
+         * next update.
+         *
+         * @param color_correction the new color correction
+         */
+        void setColorCorrection(const ColorCorrection& color_correction);
+
     protected:
         /**
          * Update the physical device with the given colors. This method is always called with colors for all channels,
@@ -112,6 +173,20 @@ namespace atmo {
 
     private:
         std::vector<Color> m_channels;
+        std::vector<Color> m_written_channels;
+        bool m_written;
+        std::chrono::steady_clock::time_point m_last_write;
+        UpdatePolicy m_update_policy;
+        ColorCorrectionTable m_color_correction;
+        std::vector<Color> m_corrected_channels;
+
+        [[nodiscard]]
+        bool changed() const;
+
+        /**
+         * Write the current colors unless the update policy allows to skip them. Forced writes are never skipped.
+         */
+        void write(bool force);
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <vector>
+#include <gsl/span>
+#include "channel.hpp"
+
+namespace atmo {
+
+    /**
+     * Output packet of ca.rstenpresser AtmoLight devices. The packet buffer is allocated and its header is written
+     * once, encoding only writes the channel colors in place.
+     */
+    class AtmoLightPacket {
+    public:
+        /**
+         * The number of channels of an AtmoLight.
+         */
+        static constexpr std::size_t CHANNELS{4};
+
+        AtmoLightPacket();
+
+        /**
+         * Encode the given colors into the packet buffer.
+         *
+         * @param channels the colors of all channels
+         * @return the packet, valid until the next call
+         */
+        gsl::span<const unsigned char> encode(gsl::span<const Color> channels);
+
+    private:
+        std::vector<unsigned char> m_buffer;
+    };
+
+    /**
+     * Output packet of ca.rstenpresser KarateLight devices. The packet buffer is allocated and its header is written
+     * once, encoding only writes the channel colors and the checksum in place.
+     */
+    class KarateLightPacket {
+    public:
+        /**
+         * The number of channels of a KarateLight.
+         */
+        static constexpr std::size_t CHANNELS{16};
+
+        KarateLightPacket();
+
+        /**
+         * Encode the given colors into the packet buffer.
+         *
+         * @param channels the colors of all channels
+         * @return the packet, valid until the next call
+         */
+        gsl::span<const unsigned char> encode(gsl::span<const Color> channels);
+
+    private:
+        std::vector<unsigned char> m_buffer;
+    };
+
+}
@@ -0,0 +1,168 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <gsl/span>
+#include <boost/asio.hpp>
+#include "device.hpp"
+
+namespace atmo {
+
+    /**
+     * Configuration of a network output device.
+     */
+    struct NetworkConfig {
+        /**
+         * The host name or IP address of the receiver. Broadcast addresses are supported.
+         */
+        std::string address{};
+
+        /**
+         * The UDP port of the receiver or 0 for the default port of the protocol.
+         */
+        std::uint16_t port{0};
+
+        /**
+         * The first universe (E1.31 and Art-Net only). Defaults to 1 for E1.31 (data universes 1 to 63999) and 0 for
+         * Art-Net.
+         */
+        std::optional<std::uint16_t> universe{};
+
+        /**
+         * Send a synchronization packet after all universes of a frame, so receivers show all universes at once
+         * (E1.31 and Art-Net only; DDP always marks the last packet of a frame).
+         */
+        bool sync{false};
+
+        /**
+         * The E1.31 synchronization universe (1 to 63999). Defaults to the first universe.
+         */
+        std::optional<std::uint16_t> sync_universe{};
+    };
+
+    /**
+     * Abstract base class for devices that receive their colors by UDP packets.
+     *
+     * Child classes have to override the writePackets() method, which encodes the colors into preallocated packets
+     * and sends them by send(). The socket is non-blocking: if the socket buffer is full, the packet is dropped
+     * instead of stalling the caller, because the next frame follows shortly.
+     */
+    class UDPAtmoDevice : public BaseAtmoDevice {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param address the host name or IP address of the receiver
+         * @param port the UDP port of the receiver
+         * @param channels the number of channels
+         */
+        UDPAtmoDevice(const std::string& address,
+                      std::uint16_t port,
+                      std::size_t channels);
+
+        void reset() final;
+
+    protected:
+        /**
+         * Encode the new colors of all channels and send them.
+         *
+         * @param channels the channel colors
+         */
+        virtual void writePackets(gsl::span<const Color> channels) = 0;
+
+        /**
+         * Send one packet to the receiver.
+         *
+         * @param packet the packet
+         */
+        void send(gsl::span<const unsigned char> packet);
+
+        void update(gsl::span<const Color> channels) final;
+
+    private:
+        std::string m_address;
+        std::uint16_t m_port;
+        boost::asio::io_context m_io_context;
+        boost::asio::ip::udp::socket m_socket;
+        boost::asio::ip::udp::endpoint m_endpoint;
+    };
+
+    /**
+     * The DDPDevice sends the colors by the Distributed Display Protocol (e.g. to WLED controllers). Long strips are
+     * split into multiple packets, the last packet of a frame has the push flag set.
+     */
+    class DDPDevice : public UDPAtmoDevice {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param config the network configuration
+         * @param channels the number of channels
+         */
+        DDPDevice(const NetworkConfig& config, std::size_t channels);
+
+    protected:
+        void writePackets(gsl::span<const Color> channels) final;
+
+    private:
+        std::vector<std::vector<unsigned char>> m_packets;
+        std::uint8_t m_sequence;
+    };
+
+    /**
+     * The E131Device sends the colors by E1.31 (Streaming ACN). Each universe carries 170 channels, long strips are
+     * split into consecutive universes.
+     */
+    class E131Device : public UDPAtmoDevice {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param config the network configuration
+         * @param channels the number of channels
+         */
+        E131Device(const NetworkConfig& config, std::size_t channels);
+
+    protected:
+        void writePackets(gsl::span<const Color> channels) final;
+
+    private:
+        std::vector<std::vector<unsigned char>> m_packets;
+        std::vector<unsigned char> m_sync_packet;
+        bool m_sync;
+        std::uint8_t m_sequence;
+        std::uint8_t m_sync_sequence;
+    };
+
+    /**
+     * The ArtNetDevice sends the colors by Art-Net (ArtDmx). Each universe carries 170 channels, long strips are split
+     * into consecutive universes.
+     */
+    class ArtNetDevice : public UDPAtmoDevice {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param config the network configuration
+         * @param channels the number of channels
+         */
+        ArtNetDevice(const NetworkConfig& config, std::size_t channels);
+
+    protected:
+        void writePackets(gsl::span<const Color> channels) final;
+
+    private:
+        std::vector<std::vector<unsigned char>> m_packets;
+        std::vector<unsigned char> m_sync_packet;
+        bool m_sync;
+        std::uint8_t m_sequence;
+    };
+
+}
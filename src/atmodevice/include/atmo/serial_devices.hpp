@@ -4,19 +4,82 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 #include <gsl/span>
 #include <boost/asio.hpp>
 #include "device.hpp"
+#include "device_packets.hpp"
 
 namespace atmo {
 
+    /**
+     * Configuration of a serial port (termios settings).
+     */
+    struct SerialConfig {
+        /**
+         * The baud rate or empty for the default baud rate of the device.
+         */
+        std::optional<unsigned int> baud_rate{};
+
+        /**
+         * The number of data bits (5-8).
+         */
+        unsigned int character_size{8};
+
+        boost::asio::serial_port_base::parity::type parity{boost::asio::serial_port_base::parity::none};
+
+        boost::asio::serial_port_base::stop_bits::type stop_bits{boost::asio::serial_port_base::stop_bits::one};
+
+        boost::asio::serial_port_base::flow_control::type flow_control{
+                boost::asio::serial_port_base::flow_control::none};
+    };
+
+    /**
+     * Throughput and latency of the writes to a serial port since it has been opened.
+     */
+    struct SerialStatistics {
+        /**
+         * The number of frames written to the port.
+         */
+        std::uint64_t frames{0};
+
+        /**
+         * The number of frames that have been replaced by a newer frame before they could be written.
+         */
+        std::uint64_t replaced_frames{0};
+
+        /**
+         * The number of bytes written to the port.
+         */
+        std::uint64_t bytes{0};
+
+        /**
+         * The sum of the latencies of all written frames, from the update until the write has completed.
+         */
+        std::chrono::microseconds total_latency{0};
+
+        /**
+         * The highest latency of a written frame.
+         */
+        std::chrono::microseconds max_latency{0};
+    };
+
     /**
      * Abstract base class for devices that use a serial port (TTY) interface.
      *
      * Child classes have to override the writeBuffer() method. This method is called to assemble the output buffer that
      * is written to the serial port.
+     *
+     * Buffers are written asynchronously by an I/O thread of the device, so update() does not wait for slow ports.
+     * While a write is in progress, at most one further buffer is queued and a newer frame replaces it. Write errors
+     * are reported by the next update(). Once the device has been created, the port is only accessed by the I/O thread.
      */
     class SerialPortAtmoDevice : public BaseAtmoDevice {
     public:
@@ -24,31 +87,83 @@ namespace atmo {
          * Constructor.
          *
          * @param filename the (file) name of the serial device (e.g. COM1 on Windows or /dev/ttyUSB0 on Linux)
-         * @param baud_rate the baud rate for the serial interface
+         * @param default_baud_rate the baud rate for the serial interface unless configured otherwise
+         * @param config the serial port configuration
          * @param channels the number of channels
          */
         SerialPortAtmoDevice(const std::string& filename,
-                             unsigned int baud_rate,
+                             unsigned int default_baud_rate,
+                             const SerialConfig& config,
                              std::size_t channels);
 
+        /**
+         * Destructor. Waits for pending writes to complete, so the last frame is not lost.
+         */
+        ~SerialPortAtmoDevice() override;
+
         void reset() final;
 
+        /**
+         * @return the write statistics since the port has been opened
+         */
+        [[nodiscard]]
+        SerialStatistics statistics() const;
+
     protected:
         /**
-         * Write an output buffer that contains the new colors of all channels.
+         * Write an output buffer that contains the new colors of all channels. The buffer is owned by the child class
+         * and reused for every update.
          *
          * @param channels the channel colors
-         * @return the output buffer
+         * @return the output buffer, valid until the next call
          */
-        virtual std::vector<unsigned char> writeBuffer(gsl::span<const Color> channels) = 0;
+        virtual gsl::span<const unsigned char> writeBuffer(gsl::span<const Color> channels) = 0;
 
         void update(gsl::span<const Color> channels) final;
 
     private:
+        using Clock = std::chrono::steady_clock;
+
         std::string m_filename;
-        unsigned int m_baud_rate;
-        boost::asio::io_service m_io_service;
+        SerialConfig m_config;
+        boost::asio::io_context m_io_context;
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_work_guard;
         boost::asio::serial_port m_serial_port;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_write_completed;
+        std::vector<unsigned char> m_sending;
+        std::vector<unsigned char> m_queued;
+        Clock::time_point m_sending_time;
+        Clock::time_point m_queued_time;
+        bool m_writing;
+        bool m_queued_pending;
+        boost::system::error_code m_error;
+        SerialStatistics m_statistics;
+        SerialStatistics m_reported_statistics;
+        Clock::time_point m_report_time;
+        std::thread m_io_thread;
+
+        /**
+         * Open and configure a new serial port.
+         */
+        boost::asio::serial_port openPort();
+
+        /**
+         * Start writing the queued buffer. Must only be called by the I/O thread and requires m_mutex to be locked.
+         */
+        void startWrite();
+
+        void onWriteCompleted(const boost::system::error_code& error, std::size_t bytes);
+
+        /**
+         * Wait until no write is in progress. Requires the given lock of m_mutex.
+         */
+        bool waitForWrites(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout);
+
+        /**
+         * Log the throughput and latency since the last report. Requires m_mutex to be locked.
+         */
+        void report(Clock::time_point now);
     };
 
     /**
@@ -60,11 +175,15 @@ namespace atmo {
          * Constructor.
          *
          * @param filename the (file) name of the serial device (e.g. COM1 on Windows or /dev/ttyUSB0 on Linux)
+         * @param config the serial port configuration, the default baud rate is 38400
          */
-        explicit AtmoLight(const std::string& filename);
+        explicit AtmoLight(const std::string& filename, const SerialConfig& config = {});
 
     protected:
-        std::vector<unsigned char> writeBuffer(gsl::span<const Color> channels) final;
+        gsl::span<const unsigned char> writeBuffer(gsl::span<const Color> channels) final;
+
+    private:
+        AtmoLightPacket m_packet;
     };
 
     /**
@@ -76,11 +195,15 @@ namespace atmo {
          * Constructor.
          *
          * @param filename the (file) name of the serial device (e.g. COM1 on Windows or /dev/ttyACM0 on Linux)
+         * @param config the serial port configuration, the default baud rate is 57600
          */
-        explicit KarateLight(const std::string& port_name);
+        explicit KarateLight(const std::string& port_name, const SerialConfig& config = {});
 
     protected:
-        std::vector<unsigned char> writeBuffer(gsl::span<const Color> channels) final;
+        gsl::span<const unsigned char> writeBuffer(gsl::span<const Color> channels) final;
+
+    private:
+        KarateLightPacket m_packet;
     };
 
 }
\ No newline at end of file
@@ -4,12 +4,89 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace atmo {
+
+    /**
+     * Configuration of a SPI interface.
+     *
+     * Frames that exceed max_message_size (or the maximum number of transfer segments of one ioctl call) are written
+     * by several ioctl calls. The bus may be idle between these calls, so strips that latch the colors when the clock
+     * is idle (e.g. WS2801) can show a partially updated frame. Choose max_message_size large enough for a complete
+     * frame for such strips.
+     */
+    struct SPIConfig {
+        /**
+         * The SPI clock in Hz.
+         */
+        std::uint32_t speed{500000};
+
+        /**
+         * The SPI mode (0 to 3), i.e. the clock polarity and phase.
+         */
+        std::uint8_t mode{0};
+
+        /**
+         * The maximum number of bytes of a single transfer segment, e.g. the DMA limit of the SPI controller.
+         */
+        std::size_t max_transfer_size{4096};
+
+        /**
+         * The maximum number of bytes of all segments written by one ioctl call. For spidev, this is the bufsiz module
+         * parameter (4096 bytes by default).
+         */
+        std::size_t max_message_size{4096};
+    };
+
+    /**
+     * A part of an output buffer that is written as one SPI transfer segment.
+     */
+    struct SPISegment {
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    /**
+     * The split of an output buffer into SPI transfer segments and ioctl calls.
+     */
+    struct SPITransfers {
+        /**
+         * The transfer segments in buffer order.
+         */
+        std::vector<SPISegment> segments;
+
+        /**
+         * The number of consecutive segments written by each ioctl call.
+         */
+        std::vector<std::size_t> messages;
+    };
+
+    /**
+     * Split an output buffer into transfer segments of at most SPIConfig::max_transfer_size bytes and group them into
+     * as few messages as possible. A message contains at most SPIConfig::max_message_size bytes and max_segments
+     * segments.
+     *
+     * @param size the size of the output buffer in bytes
+     * @param config the SPI interface configuration
+     * @param max_segments the maximum number of segments of one message
+     * @return the segments and messages
+     */
+    [[nodiscard]]
+    SPITransfers splitSPITransfers(std::size_t size, const SPIConfig& config, std::size_t max_segments);
+
+}
+
 #ifdef WITH_SPI
 
 #include <string>
 #include <vector>
 #include <gsl/span>
+#include <linux/spi/spidev.h>
 #include "device.hpp"
+#include "spi_strip_packets.hpp"
 
 namespace atmo {
 
@@ -17,7 +94,8 @@ namespace atmo {
      * Abstract base class for devices accessible by a SPI interface.
      *
      * Child classes have to override the writeBuffer() method. This method is called to assemble the output buffer that
-     * is written to the SPI interface.
+     * is written to the SPI interface. Buffers exceeding the configured transfer or message size are split into
+     * multiple transfer segments, which are written with as few ioctl calls as possible.
      */
     class SPIDevice : public BaseAtmoDevice {
     public:
@@ -26,9 +104,11 @@ namespace atmo {
          *
          * @param filename the (file) name of the SPI port (e.g. /dev/spidev0.0)
          * @param channels the number of available channels
+         * @param config the SPI interface configuration
          */
         SPIDevice(const std::string& filename,
-                  std::size_t channels);
+                  std::size_t channels,
+                  const SPIConfig& config);
 
         ~SPIDevice() override;
 
@@ -36,40 +116,64 @@ namespace atmo {
 
     protected:
         /**
-         * Write an output buffer that contains the new colors of all channels.
+         * Write an output buffer that contains the new colors of all channels. The buffer is owned by the child class
+         * and reused for every update.
          *
          * @param channels the channel colors
-         * @return the output buffer
+         * @return the output buffer, valid until the next call
          */
-        virtual std::vector<unsigned char> writeBuffer(gsl::span<const Color> channels) = 0;
+        virtual gsl::span<const unsigned char> writeBuffer(gsl::span<const Color> channels) = 0;
 
         void update(gsl::span<const Color> channels) final;
 
     private:
         std::string m_filename;
+        SPIConfig m_config;
         int m_file_descriptor;
+        std::vector<spi_ioc_transfer> m_transfers;
+        std::size_t m_buffer_size;
+        SPITransfers m_split;
 
         void closeDevice();
     };
 
     /**
-     * The DotStar class allows to control Adafruit Dotstar LEDs (or other APA102C controlled LEDs).
+     * A SPI LED strip whose packets are encoded by the given protocol, e.g. SPIStrip<WS2801Protocol>.
+     *
+     * @tparam Protocol the frame layout and LED encoding of the strip, see SPIStripPacket
      */
-    class DotStar : public SPIDevice {
+    template<class StripProtocol>
+    class SPIStrip : public SPIDevice {
     public:
+        using Protocol = StripProtocol;
+
         /**
          * Constructor.
          *
          * @param filename the (file) name of the SPI port (e.g. /dev/spidev0.0)
          * @param channels the number of available channels
+         * @param config the SPI interface configuration
          */
-        DotStar(const std::string& filename,
-                std::size_t channels);
+        SPIStrip(const std::string& filename,
+                 std::size_t channels,
+                 const SPIConfig& config = {}) :
+                SPIDevice{filename, channels, config},
+                m_packet{channels} {}
 
     protected:
-        std::vector<unsigned char> writeBuffer(gsl::span<const Color> channels) override;
+        gsl::span<const unsigned char> writeBuffer(gsl::span<const Color> channels) final {
+            return m_packet.encode(channels);
+        }
+
+    private:
+        SPIStripPacket<Protocol> m_packet;
     };
 
+    /**
+     * The DotStar class allows to control Adafruit Dotstar LEDs (or other APA102C controlled LEDs).
+     */
+    using DotStar = SPIStrip<APA102Protocol<GlobalBrightness::Color>>;
+
 }
 
 #endif
\ No newline at end of file
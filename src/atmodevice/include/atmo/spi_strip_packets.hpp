@@ -0,0 +1,248 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <gsl/span>
+#include <fmt/format.h>
+#include "channel.hpp"
+
+namespace atmo {
+
+    /**
+     * Strategy for the 5 bit global brightness field of APA102 and SK9822 LEDs.
+     */
+    enum class GlobalBrightness {
+        /**
+         * Always use the maximum global brightness, the colors are sent unchanged.
+         */
+        Full,
+
+        /**
+         * Derive the global brightness from the mean of the color components, the colors are sent unchanged. This
+         * dims dark colors twice and has been the behaviour of the DotStar device.
+         */
+        Color,
+
+        /**
+         * Use the smallest global brightness that can still represent the brightest color component and scale up the
+         * colors accordingly. Dark colors gain up to 5 bits of effective resolution.
+         */
+        HighDepth
+    };
+
+    /**
+     * The APA102 protocol (e.g. Adafruit DotStar): a start frame of 32 zero bits, one 32 bit frame per LED with the
+     * global brightness and the colors in BGR order, and an end frame that provides the clock pulses needed to shift
+     * the data through all LEDs.
+     */
+    template<GlobalBrightness Brightness>
+    struct APA102Protocol {
+        static constexpr std::size_t START_FRAME_LENGTH{4};
+        static constexpr std::size_t FRAME_LENGTH{4};
+        static constexpr unsigned char END_FRAME_BYTE{0xFF};
+
+        static constexpr std::size_t endFrameLength(std::size_t leds) {
+            // Each LED delays the clock by half a cycle, so leds / 2 additional clock pulses are required.
+            return std::max<std::size_t>(4, (leds + 15) / 16);
+        }
+
+        static constexpr unsigned char BRIGHTNESS_MARKER{0b11100000};
+        static constexpr unsigned int MAX_BRIGHTNESS{31};
+
+        /**
+         * Global brightness of the Color strategy, indexed by the sum of the color components.
+         */
+        static constexpr auto COLOR_BRIGHTNESS = []() {
+            std::array<unsigned char, 3 * 255 + 1> table{};
+            for (unsigned int sum = 0; sum < table.size(); ++sum) {
+                table[sum] = static_cast<unsigned char>(sum * MAX_BRIGHTNESS / (3 * 255));
+            }
+            return table;
+        }();
+
+        /**
+         * Global brightness of the HighDepth strategy, indexed by the brightest color component.
+         */
+        static constexpr auto HIGH_DEPTH_BRIGHTNESS = []() {
+            std::array<unsigned char, 256> table{};
+            for (unsigned int value = 0; value < table.size(); ++value) {
+                const auto brightness = (value * MAX_BRIGHTNESS + 254) / 255;
+                table[value] = static_cast<unsigned char>(std::max(brightness, 1U));
+            }
+            return table;
+        }();
+
+        /**
+         * Scaled color components of the HighDepth strategy, indexed by the global brightness and the component.
+         */
+        static constexpr auto HIGH_DEPTH_SCALE = []() {
+            std::array<std::array<unsigned char, 256>, MAX_BRIGHTNESS + 1> table{};
+            for (unsigned int brightness = 1; brightness <= MAX_BRIGHTNESS; ++brightness) {
+                for (unsigned int value = 0; value < 256; ++value) {
+                    const auto scaled = (2 * value * MAX_BRIGHTNESS + brightness) / (2 * brightness);
+                    table[brightness][value] = static_cast<unsigned char>(std::min(scaled, 255U));
+                }
+            }
+            return table;
+        }();
+
+        static void encode(Color color, unsigned char* frame) {
+            if constexpr (Brightness == GlobalBrightness::Full) {
+                frame[0] = BRIGHTNESS_MARKER | MAX_BRIGHTNESS;
+                frame[1] = color.blue;
+                frame[2] = color.green;
+                frame[3] = color.red;
+            } else if constexpr (Brightness == GlobalBrightness::Color) {
+                frame[0] = BRIGHTNESS_MARKER | COLOR_BRIGHTNESS[color.red + color.green + color.blue];
+                frame[1] = color.blue;
+                frame[2] = color.green;
+                frame[3] = color.red;
+            } else {
+                const auto brightness = HIGH_DEPTH_BRIGHTNESS[std::max({color.red, color.green, color.blue})];
+                const auto& scale = HIGH_DEPTH_SCALE[brightness];
+                frame[0] = BRIGHTNESS_MARKER | brightness;
+                frame[1] = scale[color.blue];
+                frame[2] = scale[color.green];
+                frame[3] = scale[color.red];
+            }
+        }
+    };
+
+    /**
+     * The SK9822 protocol. The LED frames are compatible to APA102, but the SK9822 latches the new colors with a zero
+     * reset frame, so the end frame consists of zero bits.
+     */
+    template<GlobalBrightness Brightness>
+    struct SK9822Protocol : APA102Protocol<Brightness> {
+        static constexpr unsigned char END_FRAME_BYTE{0x00};
+
+        static constexpr std::size_t endFrameLength(std::size_t leds) {
+            return 4 + (leds + 15) / 16;
+        }
+    };
+
+    /**
+     * The WS2801 protocol: 24 bit RGB per LED. The colors are latched after the clock has been idle for 500us, so
+     * there are no start or end frames.
+     */
+    struct WS2801Protocol {
+        static constexpr std::size_t START_FRAME_LENGTH{0};
+        static constexpr std::size_t FRAME_LENGTH{3};
+        static constexpr unsigned char END_FRAME_BYTE{0x00};
+
+        static constexpr std::size_t endFrameLength(std::size_t) {
+            return 0;
+        }
+
+        static void encode(Color color, unsigned char* frame) {
+            frame[0] = color.red;
+            frame[1] = color.green;
+            frame[2] = color.blue;
+        }
+    };
+
+    /**
+     * The LPD8806 protocol: 7 bit per color component in GRB order, each byte marked by the most significant bit.
+     * Zero bytes latch the colors, one per 32 LEDs.
+     */
+    struct LPD8806Protocol {
+        static constexpr std::size_t START_FRAME_LENGTH{0};
+        static constexpr std::size_t FRAME_LENGTH{3};
+        static constexpr unsigned char END_FRAME_BYTE{0x00};
+
+        static constexpr std::size_t endFrameLength(std::size_t leds) {
+            return (leds + 31) / 32;
+        }
+
+        static void encode(Color color, unsigned char* frame) {
+            frame[0] = 0x80 | (color.green >> 1);
+            frame[1] = 0x80 | (color.red >> 1);
+            frame[2] = 0x80 | (color.blue >> 1);
+        }
+    };
+
+    /**
+     * The P9813 protocol (e.g. Grove chainable RGB LEDs): 32 zero bits, one frame per LED with a flag byte containing
+     * the inverted two most significant bits of each component followed by the colors in BGR order, and 32 zero bits.
+     */
+    struct P9813Protocol {
+        static constexpr std::size_t START_FRAME_LENGTH{4};
+        static constexpr std::size_t FRAME_LENGTH{4};
+        static constexpr unsigned char END_FRAME_BYTE{0x00};
+
+        static constexpr std::size_t endFrameLength(std::size_t) {
+            return 4;
+        }
+
+        static void encode(Color color, unsigned char* frame) {
+            frame[0] = static_cast<unsigned char>(0xC0
+                                                  | ((~color.blue >> 2) & 0x30)
+                                                  | ((~color.green >> 4) & 0x0C)
+                                                  | ((~color.red >> 6) & 0x03));
+            frame[1] = color.blue;
+            frame[2] = color.green;
+            frame[3] = color.red;
+        }
+    };
+
+    /**
+     * Output packet of a SPI LED strip using the given protocol. The packet buffer is allocated and its start and end
+     * frames are written once, encoding only writes the LED frames in place.
+     *
+     * @tparam Protocol the frame layout and LED encoding of the strip
+     */
+    template<class Protocol>
+    class SPIStripPacket {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param channels the number of LEDs
+         */
+        explicit SPIStripPacket(std::size_t channels) :
+                m_channels{channels},
+                m_buffer(Protocol::START_FRAME_LENGTH
+                         + channels * Protocol::FRAME_LENGTH
+                         + Protocol::endFrameLength(channels),
+                         Protocol::END_FRAME_BYTE) {
+            std::fill_n(std::begin(m_buffer), Protocol::START_FRAME_LENGTH, 0);
+        }
+
+        /**
+         * Encode the given colors into the packet buffer.
+         *
+         * @param channels the colors of all channels
+         * @return the packet, valid until the next call
+         */
+        gsl::span<const unsigned char> encode(gsl::span<const Color> channels) {
+            if (channels.size() > static_cast<std::ptrdiff_t>(m_channels)) {
+                throw std::out_of_range{fmt::format("Invalid number of channels: {} available but {} given",
+                                                    m_channels, channels.size())};
+            }
+            auto* frame = m_buffer.data() + Protocol::START_FRAME_LENGTH;
+            for (const auto color : channels) {
+                Protocol::encode(color, frame);
+                frame += Protocol::FRAME_LENGTH;
+            }
+            return m_buffer;
+        }
+
+    private:
+        std::size_t m_channels;
+        std::vector<unsigned char> m_buffer;
+    };
+
+    /**
+     * The packet of Adafruit DotStar LEDs, which derives the global brightness from the colors.
+     */
+    using DotStarPacket = SPIStripPacket<APA102Protocol<GlobalBrightness::Color>>;
+
+}
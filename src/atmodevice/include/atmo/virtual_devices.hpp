@@ -0,0 +1,203 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include <gsl/span>
+#include "device.hpp"
+
+namespace atmo {
+
+    /**
+     * Simulated behaviour of a virtual device.
+     */
+    struct SimulationConfig {
+        /**
+         * The time each write takes.
+         */
+        std::chrono::microseconds write_latency{0};
+
+        /**
+         * The probability (0-1) that a write fails. Failures are drawn from a fixed seed, so runs are repeatable.
+         */
+        double failure_rate{0.0};
+    };
+
+    /**
+     * Abstract base class for devices without hardware, e.g. for load tests and CI.
+     *
+     * Child classes have to override the output() method. Before a frame is output, the configured write latency is
+     * simulated and the write fails at the configured failure rate. The counters can be read concurrently to writes.
+     */
+    class VirtualAtmoDevice : public BaseAtmoDevice {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param channels the number of channels
+         * @param simulation the simulated behaviour
+         */
+        VirtualAtmoDevice(std::size_t channels, const SimulationConfig& simulation);
+
+        void reset() override;
+
+        /**
+         * @return the number of frames output since the device has been created
+         */
+        [[nodiscard]]
+        std::uint64_t frames() const;
+
+        /**
+         * @return the number of failed writes since the device has been created
+         */
+        [[nodiscard]]
+        std::uint64_t failures() const;
+
+        /**
+         * @return the number of resets since the device has been created
+         */
+        [[nodiscard]]
+        std::uint64_t resets() const;
+
+    protected:
+        /**
+         * Output a frame.
+         *
+         * @param channels the colors of all channels
+         */
+        virtual void output(gsl::span<const Color> channels) = 0;
+
+        void update(gsl::span<const Color> channels) final;
+
+    private:
+        SimulationConfig m_simulation;
+        std::mt19937 m_random;
+        std::bernoulli_distribution m_failure;
+        std::atomic<std::uint64_t> m_frames;
+        std::atomic<std::uint64_t> m_failures;
+        std::atomic<std::uint64_t> m_resets;
+    };
+
+    /**
+     * The NullDevice discards all frames.
+     */
+    class NullDevice : public VirtualAtmoDevice {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param channels the number of channels
+         * @param simulation the simulated behaviour
+         */
+        explicit NullDevice(std::size_t channels, const SimulationConfig& simulation = {});
+
+    protected:
+        void output(gsl::span<const Color> channels) final;
+    };
+
+    /**
+     * The MemoryDevice records the most recent frames in a ring buffer. Recorded frames can be read concurrently to
+     * writes.
+     */
+    class MemoryDevice : public VirtualAtmoDevice {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param channels the number of channels
+         * @param capacity the number of frames to keep
+         * @param simulation the simulated behaviour
+         */
+        MemoryDevice(std::size_t channels, std::size_t capacity, const SimulationConfig& simulation = {});
+
+        /**
+         * @return the recorded frames, oldest first
+         */
+        [[nodiscard]]
+        std::vector<std::vector<Color>> recordedFrames() const;
+
+    protected:
+        void output(gsl::span<const Color> channels) final;
+
+    private:
+        mutable std::mutex m_mutex;
+        std::vector<std::vector<Color>> m_frames;
+        std::size_t m_next;
+        std::size_t m_size;
+    };
+
+    /**
+     * The kind of file written by a FileDevice.
+     */
+    enum class FileType {
+        /**
+         * A regular file, which is truncated when opened.
+         */
+        Regular,
+
+        /**
+         * A named pipe, which is created if missing. Frames are dropped while the reader does not keep up.
+         */
+        Fifo
+    };
+
+    /**
+     * The FileDevice writes each frame as packet of raw RGB bytes (3 bytes per channel) to a file or named pipe, e.g.
+     * to be displayed by a video player reading raw video.
+     *
+     * A regular file is truncated when the device is created. A reset reopens it and appends the following frames.
+     */
+    class FileDevice : public VirtualAtmoDevice {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param filename the name of the file or named pipe
+         * @param channels the number of channels
+         * @param type the kind of file
+         * @param simulation the simulated behaviour
+         */
+        FileDevice(const std::string& filename,
+                   std::size_t channels,
+                   FileType type,
+                   const SimulationConfig& simulation = {});
+
+        ~FileDevice() override;
+
+        void reset() final;
+
+        /**
+         * @return the number of frames dropped because the reader of the named pipe did not keep up
+         */
+        [[nodiscard]]
+        std::uint64_t droppedFrames() const;
+
+    protected:
+        void output(gsl::span<const Color> channels) final;
+
+    private:
+        std::string m_filename;
+        FileType m_type;
+        int m_file_descriptor;
+        std::vector<unsigned char> m_packet;
+        std::atomic<std::uint64_t> m_dropped_frames;
+
+        /**
+         * Open the file or named pipe.
+         *
+         * @param truncate whether a regular file is truncated, otherwise frames are appended
+         */
+        void openFile(bool truncate);
+
+        void closeFile();
+    };
+
+}
@@ -0,0 +1,341 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <atmo/network_devices.hpp>
+
+#include <algorithm>
+#include <random>
+#include <fmt/format.h>
+
+namespace {
+
+    using namespace atmo;
+    using boost::asio::ip::udp;
+
+    constexpr std::uint16_t DDP_PORT{4048};
+    constexpr std::size_t DDP_HEADER_LENGTH{10};
+    constexpr std::size_t DDP_MAX_CHANNELS{480};
+    constexpr unsigned char DDP_VERSION_1{0x40};
+    constexpr unsigned char DDP_PUSH{0x01};
+    constexpr unsigned char DDP_TYPE_RGB8{0x0B};
+    constexpr unsigned char DDP_ID_DISPLAY{0x01};
+    constexpr std::uint8_t DDP_MAX_SEQUENCE{15};
+
+    constexpr std::uint16_t E131_PORT{5568};
+    constexpr std::uint16_t E131_DEFAULT_UNIVERSE{1};
+    constexpr std::uint16_t E131_MIN_UNIVERSE{1};
+    constexpr std::uint16_t E131_MAX_UNIVERSE{63999};
+    constexpr std::size_t E131_HEADER_LENGTH{126};
+    constexpr std::size_t E131_SYNC_PACKET_LENGTH{49};
+    constexpr std::array<unsigned char, 12> E131_PACKET_IDENTIFIER{
+            'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0x00, 0x00, 0x00};
+    constexpr std::uint32_t E131_VECTOR_ROOT_DATA{0x00000004};
+    constexpr std::uint32_t E131_VECTOR_ROOT_EXTENDED{0x00000008};
+    constexpr std::uint32_t E131_VECTOR_DATA_PACKET{0x00000002};
+    constexpr std::uint32_t E131_VECTOR_EXTENDED_SYNCHRONIZATION{0x00000001};
+    constexpr unsigned char E131_VECTOR_DMP_SET_PROPERTY{0x02};
+    constexpr unsigned char E131_PRIORITY{100};
+    constexpr std::size_t E131_SOURCE_NAME_LENGTH{64};
+    constexpr const char* E131_SOURCE_NAME{"atmolight"};
+    constexpr std::size_t E131_SEQUENCE_POS{111};
+    constexpr std::size_t E131_SYNC_SEQUENCE_POS{44};
+
+    constexpr std::uint16_t ARTNET_PORT{6454};
+    constexpr std::uint16_t ARTNET_DEFAULT_UNIVERSE{0};
+    constexpr std::uint16_t ARTNET_MIN_UNIVERSE{0};
+    constexpr std::uint16_t ARTNET_MAX_UNIVERSE{0x7FFF};
+    constexpr std::size_t ARTNET_HEADER_LENGTH{18};
+    constexpr std::size_t ARTNET_SYNC_PACKET_LENGTH{14};
+    constexpr std::array<unsigned char, 8> ARTNET_ID{'A', 'r', 't', '-', 'N', 'e', 't', 0x00};
+    constexpr std::uint16_t ARTNET_OP_DMX{0x5000};
+    constexpr std::uint16_t ARTNET_OP_SYNC{0x5200};
+    constexpr std::uint16_t ARTNET_PROTOCOL_VERSION{14};
+    constexpr std::size_t ARTNET_SEQUENCE_POS{12};
+
+    /**
+     * The number of RGB channels of one DMX universe (512 slots).
+     */
+    constexpr std::size_t UNIVERSE_CHANNELS{170};
+
+    void putUInt16(unsigned char* position, std::uint16_t value) {
+        position[0] = static_cast<unsigned char>(value >> 8);
+        position[1] = static_cast<unsigned char>(value);
+    }
+
+    void putUInt16LittleEndian(unsigned char* position, std::uint16_t value) {
+        position[0] = static_cast<unsigned char>(value);
+        position[1] = static_cast<unsigned char>(value >> 8);
+    }
+
+    void putUInt32(unsigned char* position, std::uint32_t value) {
+        putUInt16(position, static_cast<std::uint16_t>(value >> 16));
+        putUInt16(position + 2, static_cast<std::uint16_t>(value));
+    }
+
+    /**
+     * Root layer flags and length of an ACN PDU, which spans from the given position to the end of the packet.
+     */
+    void putPDULength(std::vector<unsigned char>& packet, std::size_t position) {
+        putUInt16(packet.data() + position, static_cast<std::uint16_t>(0x7000 | (packet.size() - position)));
+    }
+
+    std::size_t packetCount(std::size_t channels, std::size_t channels_per_packet) {
+        return (channels + channels_per_packet - 1) / channels_per_packet;
+    }
+
+    std::size_t packetChannels(std::size_t channels, std::size_t channels_per_packet, std::size_t packet) {
+        return std::min(channels_per_packet, channels - packet * channels_per_packet);
+    }
+
+    /**
+     * Copy the colors of the channels sent by the given packet to its payload in RGB order.
+     */
+    void writePayload(gsl::span<const Color> channels,
+                      std::size_t channels_per_packet,
+                      std::size_t packet,
+                      unsigned char* payload) {
+        const auto first = static_cast<std::ptrdiff_t>(packet * channels_per_packet);
+        if (first >= channels.size()) {
+            return;
+        }
+        const auto count = std::min(static_cast<std::ptrdiff_t>(channels_per_packet), channels.size() - first);
+        for (const auto color : channels.subspan(first, count)) {
+            *payload++ = color.red;
+            *payload++ = color.green;
+            *payload++ = color.blue;
+        }
+    }
+
+    std::uint16_t firstUniverse(const NetworkConfig& config,
+                                std::uint16_t default_universe,
+                                std::size_t universes,
+                                std::size_t min_universe,
+                                std::size_t max_universe) {
+        const auto universe = config.universe.value_or(default_universe);
+        if (universe < min_universe) {
+            throw std::runtime_error{fmt::format("Illegal universe {}: the first universe is {}",
+                                                 universe, min_universe)};
+        }
+        if (universe + universes > max_universe + 1) {
+            throw std::runtime_error{fmt::format(
+                    "Illegal universe {}: {} universes required, but the last universe is {}",
+                    universe, universes, max_universe)};
+        }
+        return universe;
+    }
+
+    std::array<unsigned char, 16> generateCID() {
+        std::random_device random_device{};
+        std::uniform_int_distribution<int> distribution{0, 255};
+        std::array<unsigned char, 16> cid{};
+        for (auto& byte : cid) {
+            byte = static_cast<unsigned char>(distribution(random_device));
+        }
+        // Mark the CID as random UUID (version 4, variant 1).
+        cid[6] = static_cast<unsigned char>((cid[6] & 0x0F) | 0x40);
+        cid[8] = static_cast<unsigned char>((cid[8] & 0x3F) | 0x80);
+        return cid;
+    }
+
+    void writeE131RootLayer(std::vector<unsigned char>& packet,
+                            std::uint32_t vector,
+                            const std::array<unsigned char, 16>& cid) {
+        putUInt16(packet.data(), 0x0010);
+        putUInt16(packet.data() + 2, 0x0000);
+        std::copy(std::begin(E131_PACKET_IDENTIFIER), std::end(E131_PACKET_IDENTIFIER), packet.data() + 4);
+        putPDULength(packet, 16);
+        putUInt32(packet.data() + 18, vector);
+        std::copy(std::begin(cid), std::end(cid), packet.data() + 22);
+    }
+
+    std::uint8_t nextArtNetSequence(std::uint8_t sequence) {
+        // Zero disables the sequence check of the receiver.
+        return sequence == 255 ? 1 : sequence + 1;
+    }
+
+}
+
+namespace atmo {
+
+    UDPAtmoDevice::UDPAtmoDevice(const std::string& address,
+                                 std::uint16_t port,
+                                 std::size_t channels) :
+            BaseAtmoDevice{channels},
+            m_address{address},
+            m_port{port},
+            m_io_context{},
+            m_socket{m_io_context},
+            m_endpoint{} {
+        reset();
+    }
+
+    void UDPAtmoDevice::reset() {
+        udp::resolver resolver{m_io_context};
+        const auto endpoints = resolver.resolve(udp::v4(), m_address, std::to_string(m_port));
+        if (endpoints.empty()) {
+            throw std::runtime_error{fmt::format("Could not resolve address '{}'", m_address)};
+        }
+        m_endpoint = *endpoints.begin();
+
+        if (m_socket.is_open()) {
+            m_socket.close();
+        }
+        m_socket.open(m_endpoint.protocol());
+        m_socket.set_option(boost::asio::socket_base::broadcast{true});
+        m_socket.non_blocking(true);
+    }
+
+    void UDPAtmoDevice::send(gsl::span<const unsigned char> packet) {
+        boost::system::error_code error{};
+        m_socket.send_to(boost::asio::buffer(packet.data(), packet.size()), m_endpoint, 0, error);
+        if (error == boost::asio::error::would_block || error == boost::asio::error::try_again) {
+            // The socket buffer is full, the packet is dropped in favour of the next frame.
+            return;
+        }
+        if (error) {
+            throw std::runtime_error{fmt::format("Could not send packet to '{}': {}", m_address, error.message())};
+        }
+    }
+
+    void UDPAtmoDevice::update(gsl::span<const Color> channels) {
+        writePackets(channels);
+    }
+
+    DDPDevice::DDPDevice(const NetworkConfig& config, std::size_t channels) :
+            UDPAtmoDevice{config.address, config.port > 0 ? config.port : DDP_PORT, channels},
+            m_packets(packetCount(channels, DDP_MAX_CHANNELS)),
+            m_sequence{0} {
+        for (std::size_t packet = 0; packet < m_packets.size(); ++packet) {
+            const auto data_length = packetChannels(channels, DDP_MAX_CHANNELS, packet) * 3;
+            auto& buffer = m_packets[packet];
+            buffer.resize(DDP_HEADER_LENGTH + data_length);
+            buffer[0] = DDP_VERSION_1;
+            if (packet + 1 == m_packets.size()) {
+                buffer[0] |= DDP_PUSH;
+            }
+            buffer[2] = DDP_TYPE_RGB8;
+            buffer[3] = DDP_ID_DISPLAY;
+            putUInt32(buffer.data() + 4, static_cast<std::uint32_t>(packet * DDP_MAX_CHANNELS * 3));
+            putUInt16(buffer.data() + 8, static_cast<std::uint16_t>(data_length));
+        }
+        clear();
+    }
+
+    void DDPDevice::writePackets(gsl::span<const Color> channels) {
+        m_sequence = m_sequence % DDP_MAX_SEQUENCE + 1;
+        for (std::size_t packet = 0; packet < m_packets.size(); ++packet) {
+            auto& buffer = m_packets[packet];
+            buffer[1] = m_sequence;
+            writePayload(channels, DDP_MAX_CHANNELS, packet, buffer.data() + DDP_HEADER_LENGTH);
+            send(buffer);
+        }
+    }
+
+    E131Device::E131Device(const NetworkConfig& config, std::size_t channels) :
+            UDPAtmoDevice{config.address, config.port > 0 ? config.port : E131_PORT, channels},
+            m_packets(packetCount(channels, UNIVERSE_CHANNELS)),
+            m_sync_packet{},
+            m_sync{config.sync},
+            m_sequence{0},
+            m_sync_sequence{0} {
+        const auto first_universe = firstUniverse(config, E131_DEFAULT_UNIVERSE, m_packets.size(), E131_MIN_UNIVERSE,
+                                                  E131_MAX_UNIVERSE);
+        const auto sync_universe = m_sync ? config.sync_universe.value_or(first_universe) : 0;
+        if (m_sync && (sync_universe < E131_MIN_UNIVERSE || sync_universe > E131_MAX_UNIVERSE)) {
+            throw std::runtime_error{fmt::format("Illegal synchronization universe {}: the universes are {} to {}",
+                                                 sync_universe, E131_MIN_UNIVERSE, E131_MAX_UNIVERSE)};
+        }
+        const auto cid = generateCID();
+        for (std::size_t packet = 0; packet < m_packets.size(); ++packet) {
+            const auto slots = packetChannels(channels, UNIVERSE_CHANNELS, packet) * 3;
+            auto& buffer = m_packets[packet];
+            buffer.resize(E131_HEADER_LENGTH + slots);
+            writeE131RootLayer(buffer, E131_VECTOR_ROOT_DATA, cid);
+
+            // Framing layer
+            putPDULength(buffer, 38);
+            putUInt32(buffer.data() + 40, E131_VECTOR_DATA_PACKET);
+            std::copy_n(E131_SOURCE_NAME, std::char_traits<char>::length(E131_SOURCE_NAME), buffer.data() + 44);
+            buffer[44 + E131_SOURCE_NAME_LENGTH] = E131_PRIORITY;
+            putUInt16(buffer.data() + 109, sync_universe);
+            putUInt16(buffer.data() + 113, static_cast<std::uint16_t>(first_universe + packet));
+
+            // DMP layer, the slots are preceded by the DMX start code 0.
+            putPDULength(buffer, 115);
+            buffer[117] = E131_VECTOR_DMP_SET_PROPERTY;
+            buffer[118] = 0xA1;
+            putUInt16(buffer.data() + 119, 0x0000);
+            putUInt16(buffer.data() + 121, 0x0001);
+            putUInt16(buffer.data() + 123, static_cast<std::uint16_t>(slots + 1));
+        }
+
+        if (m_sync) {
+            m_sync_packet.resize(E131_SYNC_PACKET_LENGTH);
+            writeE131RootLayer(m_sync_packet, E131_VECTOR_ROOT_EXTENDED, cid);
+            putPDULength(m_sync_packet, 38);
+            putUInt32(m_sync_packet.data() + 40, E131_VECTOR_EXTENDED_SYNCHRONIZATION);
+            putUInt16(m_sync_packet.data() + 45, sync_universe);
+        }
+        clear();
+    }
+
+    void E131Device::writePackets(gsl::span<const Color> channels) {
+        for (std::size_t packet = 0; packet < m_packets.size(); ++packet) {
+            auto& buffer = m_packets[packet];
+            buffer[E131_SEQUENCE_POS] = m_sequence;
+            writePayload(channels, UNIVERSE_CHANNELS, packet, buffer.data() + E131_HEADER_LENGTH);
+            send(buffer);
+        }
+        ++m_sequence;
+
+        if (m_sync) {
+            m_sync_packet[E131_SYNC_SEQUENCE_POS] = m_sync_sequence++;
+            send(m_sync_packet);
+        }
+    }
+
+    ArtNetDevice::ArtNetDevice(const NetworkConfig& config, std::size_t channels) :
+            UDPAtmoDevice{config.address, config.port > 0 ? config.port : ARTNET_PORT, channels},
+            m_packets(packetCount(channels, UNIVERSE_CHANNELS)),
+            m_sync_packet{},
+            m_sync{config.sync},
+            m_sequence{0} {
+        const auto first_universe = firstUniverse(config, ARTNET_DEFAULT_UNIVERSE, m_packets.size(),
+                                                  ARTNET_MIN_UNIVERSE, ARTNET_MAX_UNIVERSE);
+        for (std::size_t packet = 0; packet < m_packets.size(); ++packet) {
+            // The DMX data length has to be even.
+            const auto data_length = (packetChannels(channels, UNIVERSE_CHANNELS, packet) * 3 + 1) & ~std::size_t{1};
+            auto& buffer = m_packets[packet];
+            buffer.resize(ARTNET_HEADER_LENGTH + data_length);
+            std::copy(std::begin(ARTNET_ID), std::end(ARTNET_ID), buffer.data());
+            putUInt16LittleEndian(buffer.data() + 8, ARTNET_OP_DMX);
+            putUInt16(buffer.data() + 10, ARTNET_PROTOCOL_VERSION);
+            putUInt16LittleEndian(buffer.data() + 14, static_cast<std::uint16_t>(first_universe + packet));
+            putUInt16(buffer.data() + 16, static_cast<std::uint16_t>(data_length));
+        }
+
+        if (m_sync) {
+            m_sync_packet.resize(ARTNET_SYNC_PACKET_LENGTH);
+            std::copy(std::begin(ARTNET_ID), std::end(ARTNET_ID), m_sync_packet.data());
+            putUInt16LittleEndian(m_sync_packet.data() + 8, ARTNET_OP_SYNC);
+            putUInt16(m_sync_packet.data() + 10, ARTNET_PROTOCOL_VERSION);
+        }
+        clear();
+    }
+
+    void ArtNetDevice::writePackets(gsl::span<const Color> channels) {
+        m_sequence = nextArtNetSequence(m_sequence);
+        for (std::size_t packet = 0; packet < m_packets.size(); ++packet) {
+            auto& buffer = m_packets[packet];
+            buffer[ARTNET_SEQUENCE_POS] = m_sequence;
+            writePayload(channels, UNIVERSE_CHANNELS, packet, buffer.data() + ARTNET_HEADER_LENGTH);
+            send(buffer);
+        }
+
+        if (m_sync) {
+            send(m_sync_packet);
+        }
+    }
+
+}
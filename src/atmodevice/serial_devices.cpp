@@ -3,88 +3,227 @@
 //
 
 #include <atmo/serial_devices.hpp>
-#include <algorithm>
-#include <numeric>
+#include <future>
 #include <fmt/format.h>
+#include <spdlog/spdlog.h>
 
 namespace {
-    constexpr std::array<unsigned char, 7> ATMOLIGHT_HEADER = {
-            0xFF,
-            0x00,
-            0x00,
-            0x0F,
-            0x00,
-            0x00,
-            0x00};
-    constexpr auto ATMOLIGHT_PACKET_SIZE = ATMOLIGHT_HEADER.size() + 4 * 3;
-    constexpr std::array<unsigned char, 4> KARATELIGHT_HEADER = {
-            0xAA,
-            0x12,
-            0x00,
-            0x30};
-    constexpr auto KARATELIGHT_PACKET_SIZE = 52;
-    constexpr unsigned char KARATELIGHT_CHECKSUM_BYTE_POS = 2;
-
-    auto calculateChecksum(gsl::span<const unsigned char> buffer) {
-        return std::accumulate(std::begin(buffer), std::end(buffer), 0, [](auto a, auto b) { return a ^ b; });
-    }
+
+    /**
+     * How long to wait for a pending write when the port is reset or closed.
+     */
+    constexpr std::chrono::milliseconds WRITE_TIMEOUT{1000};
+
+    /**
+     * The interval of the throughput and latency report.
+     */
+    constexpr std::chrono::seconds REPORT_INTERVAL{10};
+
 }
 
 namespace atmo {
 
     SerialPortAtmoDevice::SerialPortAtmoDevice(const std::string& filename,
-                                               unsigned int baud_rate,
+                                               unsigned int default_baud_rate,
+                                               const SerialConfig& config,
                                                std::size_t channels) :
             BaseAtmoDevice{channels},
             m_filename{filename},
-            m_baud_rate{baud_rate},
-            m_io_service{},
-            m_serial_port{m_io_service} {
-        reset();
+            m_config{config},
+            m_io_context{},
+            m_work_guard{boost::asio::make_work_guard(m_io_context)},
+            m_serial_port{m_io_context},
+            m_mutex{},
+            m_write_completed{},
+            m_sending{},
+            m_queued{},
+            m_sending_time{},
+            m_queued_time{},
+            m_writing{false},
+            m_queued_pending{false},
+            m_error{},
+            m_statistics{},
+            m_reported_statistics{},
+            m_report_time{},
+            m_io_thread{} {
+        if (!m_config.baud_rate) {
+            m_config.baud_rate = default_baud_rate;
+        }
+        m_serial_port = openPort();
+        m_report_time = Clock::now();
+        // Start the I/O thread after the port has been opened, so a failing open does not leave it running. From now
+        // on, the port is only accessed by the I/O thread.
+        m_io_thread = std::thread{[this]() { m_io_context.run(); }};
+    }
+
+    SerialPortAtmoDevice::~SerialPortAtmoDevice() {
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            if (!waitForWrites(lock, WRITE_TIMEOUT)) {
+                spdlog::warn("Serial port '{}' did not complete pending writes", m_filename);
+            }
+        }
+        m_work_guard.reset();
+        m_io_context.stop();
+        if (m_io_thread.joinable()) {
+            m_io_thread.join();
+        }
     }
 
     void SerialPortAtmoDevice::update(gsl::span<const Color> channels) {
-        boost::asio::write(m_serial_port, boost::asio::buffer(writeBuffer(channels)));
+        const auto buffer = writeBuffer(channels);
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if (m_error) {
+            const auto error = std::exchange(m_error, {});
+            throw std::runtime_error{fmt::format("Could not write to serial port '{}': {}",
+                                                 m_filename, error.message())};
+        }
+        if (m_queued_pending) {
+            ++m_statistics.replaced_frames;
+        }
+        m_queued.assign(std::begin(buffer), std::end(buffer));
+        m_queued_time = Clock::now();
+        m_queued_pending = true;
+        if (!m_writing) {
+            // Serial port operations are not thread-safe, so the write is started by the I/O thread.
+            m_writing = true;
+            boost::asio::post(m_io_context, [this]() {
+                std::lock_guard<std::mutex> write_lock{m_mutex};
+                startWrite();
+            });
+        }
     }
 
     void SerialPortAtmoDevice::reset() {
-        m_serial_port = {m_io_service, m_filename.c_str()};
-        m_serial_port.set_option(boost::asio::serial_port_base::baud_rate(m_baud_rate));
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_queued_pending = false;
+        if (m_writing) {
+            // Serial port operations are not thread-safe, so the pending write is cancelled by the I/O thread.
+            boost::asio::post(m_io_context, [this]() {
+                boost::system::error_code error{};
+                m_serial_port.cancel(error);
+            });
+            if (!waitForWrites(lock, WRITE_TIMEOUT)) {
+                throw std::runtime_error{fmt::format("Could not cancel pending write to serial port '{}'", m_filename)};
+            }
+        }
+
+        // The new port is opened by the calling thread, but only the I/O thread replaces the current one. No write is
+        // in progress, so m_mutex is released meanwhile and queued handlers of the I/O thread cannot block on it.
+        lock.unlock();
+        auto serial_port = openPort();
+        std::promise<void> replaced{};
+        boost::asio::post(m_io_context, [this, &serial_port, &replaced]() {
+            m_serial_port = std::move(serial_port);
+            replaced.set_value();
+        });
+        replaced.get_future().get();
+        lock.lock();
+
+        m_error = {};
+        m_statistics = {};
+        m_reported_statistics = {};
+        m_report_time = Clock::now();
     }
 
-    AtmoLight::AtmoLight(const std::string& port_name) :
-            SerialPortAtmoDevice{port_name, 38400, 4} {
-        clear();
+    boost::asio::serial_port SerialPortAtmoDevice::openPort() {
+        boost::asio::serial_port serial_port{m_io_context, m_filename};
+        serial_port.set_option(boost::asio::serial_port_base::baud_rate{*m_config.baud_rate});
+        serial_port.set_option(boost::asio::serial_port_base::character_size{m_config.character_size});
+        serial_port.set_option(boost::asio::serial_port_base::parity{m_config.parity});
+        serial_port.set_option(boost::asio::serial_port_base::stop_bits{m_config.stop_bits});
+        serial_port.set_option(boost::asio::serial_port_base::flow_control{m_config.flow_control});
+        return serial_port;
     }
 
-    std::vector<unsigned char> AtmoLight::writeBuffer(gsl::span<const Color> channels) {
-        std::vector<unsigned char> buffer{};
-        buffer.resize(ATMOLIGHT_PACKET_SIZE);
-        auto payload_position = std::copy(std::begin(ATMOLIGHT_HEADER), std::end(ATMOLIGHT_HEADER), std::begin(buffer));
-        for (auto color : channels) {
-            std::array<unsigned char, 3> channel{color.red, color.green, color.blue};
-            payload_position = std::copy(std::begin(channel), std::end(channel), payload_position);
+    SerialStatistics SerialPortAtmoDevice::statistics() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_statistics;
+    }
+
+    void SerialPortAtmoDevice::startWrite() {
+        if (!m_queued_pending) {
+            // The queued buffer has been dropped by reset() in the meantime.
+            m_writing = false;
+            m_write_completed.notify_all();
+            return;
         }
-        return buffer;
+        m_sending.swap(m_queued);
+        m_sending_time = m_queued_time;
+        m_queued_pending = false;
+        m_writing = true;
+        boost::asio::async_write(m_serial_port,
+                                 boost::asio::buffer(m_sending),
+                                 [this](const boost::system::error_code& error, std::size_t bytes) {
+                                     onWriteCompleted(error, bytes);
+                                 });
     }
 
-    KarateLight::KarateLight(const std::string& port_name) :
-            SerialPortAtmoDevice{port_name, 57600, 16} {
-        clear();
+    void SerialPortAtmoDevice::onWriteCompleted(const boost::system::error_code& error, std::size_t bytes) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_writing = false;
+        if (!error) {
+            const auto now = Clock::now();
+            const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(now - m_sending_time);
+            ++m_statistics.frames;
+            m_statistics.bytes += bytes;
+            m_statistics.total_latency += latency;
+            m_statistics.max_latency = std::max(m_statistics.max_latency, latency);
+            report(now);
+
+            if (m_queued_pending) {
+                startWrite();
+            }
+        } else if (error != boost::asio::error::operation_aborted) {
+            m_error = error;
+            m_queued_pending = false;
+        }
+        m_write_completed.notify_all();
     }
 
-    std::vector<unsigned char> KarateLight::writeBuffer(gsl::span<const Color> channels) {
-        std::vector<unsigned char> buffer{};
-        buffer.resize(KARATELIGHT_PACKET_SIZE);
-        auto payload_position = std::copy(std::begin(KARATELIGHT_HEADER),
-                                          std::end(KARATELIGHT_HEADER),
-                                          std::begin(buffer));
-        for (auto color : channels) {
-            std::array<unsigned char, 3> channel{color.green, color.blue, color.red};
-            payload_position = std::copy(std::begin(channel), std::end(channel), payload_position);
+    bool SerialPortAtmoDevice::waitForWrites(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout) {
+        return m_write_completed.wait_for(lock, timeout, [this]() { return !m_writing; });
+    }
+
+    void SerialPortAtmoDevice::report(Clock::time_point now) {
+        const auto elapsed = now - m_report_time;
+        if (elapsed < REPORT_INTERVAL) {
+            return;
         }
-        buffer[KARATELIGHT_CHECKSUM_BYTE_POS] = calculateChecksum(buffer);
-        return buffer;
+        const auto seconds = std::chrono::duration<double>(elapsed).count();
+        const auto frames = m_statistics.frames - m_reported_statistics.frames;
+        const auto latency = m_statistics.total_latency - m_reported_statistics.total_latency;
+        spdlog::debug("Serial port '{}': {:.1f} frames/s, {:.0f} bytes/s, {} frames replaced, "
+                      "latency {}us average, {}us max",
+                      m_filename,
+                      frames / seconds,
+                      (m_statistics.bytes - m_reported_statistics.bytes) / seconds,
+                      m_statistics.replaced_frames - m_reported_statistics.replaced_frames,
+                      frames > 0 ? latency.count() / static_cast<std::int64_t>(frames) : 0,
+                      m_statistics.max_latency.count());
+        m_reported_statistics = m_statistics;
+        m_report_time = now;
+    }
+
+    AtmoLight::AtmoLight(const std::string& port_name, const SerialConfig& config) :
+            SerialPortAtmoDevice{port_name, 38400, config, AtmoLightPacket::CHANNELS},
+            m_packet{} {
+        clear();
     }
 
-}
\ No newline at end of file
+    gsl::span<const unsigned char> AtmoLight::writeBuffer(gsl::span<const Color> channels) {
+        return m_packet.encode(channels);
+    }
+
+    KarateLight::KarateLight(const std::string& port_name, const SerialConfig& config) :
+            SerialPortAtmoDevice{port_name, 57600, config, KarateLightPacket::CHANNELS},
+            m_packet{} {
+        clear();
+    }
+
+    gsl::span<const unsigned char> KarateLight::writeBuffer(gsl::span<const Color> channels) {
+        return m_packet.encode(channels);
+    }
+
+}
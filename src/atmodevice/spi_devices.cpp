@@ -2,23 +2,52 @@
 // Created by Benedikt on 30.08.2020.
 //
 
-#ifdef WITH_SPI
-
 #include <atmo/spi_devices.hpp>
 
+#include <algorithm>
+#include <stdexcept>
+
+namespace atmo {
+
+    SPITransfers splitSPITransfers(std::size_t size, const SPIConfig& config, std::size_t max_segments) {
+        if (config.max_transfer_size == 0 || config.max_message_size == 0 || max_segments == 0) {
+            throw std::runtime_error{"Illegal SPI transfer size: 0"};
+        }
+        // A segment never exceeds the message size, so each message consists of at least one complete segment.
+        const auto transfer_size = std::min(config.max_transfer_size, config.max_message_size);
+        SPITransfers transfers{};
+        std::size_t offset{0};
+        while (offset < size) {
+            std::size_t segments{0};
+            std::size_t message_size{0};
+            while (offset < size && segments < max_segments && message_size < config.max_message_size) {
+                const auto length = std::min({transfer_size, size - offset, config.max_message_size - message_size});
+                transfers.segments.push_back(SPISegment{offset, length});
+                offset += length;
+                message_size += length;
+                ++segments;
+            }
+            transfers.messages.push_back(segments);
+        }
+        return transfers;
+    }
+
+}
+
+#ifdef WITH_SPI
+
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <linux/spi/spidev.h>
-#include <array>
 #include <spdlog/spdlog.h>
 
 namespace {
 
-    constexpr std::array<unsigned char, 4> DOTSTAR_START_FRAME{0x0, 0x0, 0x0, 0x0};
-    constexpr std::array<unsigned char, 4> DOTSTAR_END_FRAME{0xFF, 0xFF, 0xFF, 0xFF};
-    constexpr std::size_t DOTSTAR_FRAME_LENGTH{4};
-    constexpr unsigned char DOTSTAR_BRIGHTNESS{0b11100000};
+    /**
+     * The maximum number of transfer segments of one SPI_IOC_MESSAGE, limited by the size field of the ioctl number.
+     */
+    constexpr std::size_t MAX_SEGMENTS{((1U << _IOC_SIZEBITS) - 1) / sizeof(spi_ioc_transfer)};
 
     void ioError(const std::string& error_message) {
         const auto error = errno;
@@ -30,21 +59,51 @@ namespace {
 namespace atmo {
 
     SPIDevice::SPIDevice(const std::string& filename,
-                         std::size_t channels) :
+                         std::size_t channels,
+                         const SPIConfig& config) :
             BaseAtmoDevice{channels},
             m_filename{filename},
-            m_file_descriptor{-1} {
+            m_config{config},
+            m_file_descriptor{-1},
+            m_transfers{},
+            m_buffer_size{0},
+            m_split{} {
+        if (m_config.speed == 0) {
+            throw std::runtime_error{"Illegal SPI speed: 0"};
+        }
+        if (m_config.mode > 3) {
+            throw std::runtime_error{fmt::format("Illegal SPI mode: {}", m_config.mode)};
+        }
+        if (m_config.max_transfer_size == 0 || m_config.max_message_size == 0) {
+            throw std::runtime_error{"Illegal SPI transfer size: 0"};
+        }
+        const auto transfer_size = std::min(m_config.max_transfer_size, m_config.max_message_size);
+        const auto segments = (m_config.max_message_size + transfer_size - 1) / transfer_size;
+        m_transfers.resize(std::min(segments, MAX_SEGMENTS));
         reset();
     }
 
     void SPIDevice::update(gsl::span<const Color> channels) {
-        auto buffer = writeBuffer(channels);
-        spi_ioc_transfer transfer{};
-        std::memset(&transfer, 0, sizeof(transfer));
-        transfer.tx_buf = reinterpret_cast<__u64>(buffer.data());
-        transfer.len = buffer.size();
-        if (ioctl(m_file_descriptor, SPI_IOC_MESSAGE(1), &transfer) < 0) {
-            ioError("Could not write SPI packet");
+        const auto buffer = writeBuffer(channels);
+        const auto size = static_cast<std::size_t>(buffer.size());
+        // The buffer size of a device rarely changes, so the split is only computed again for a new size.
+        if (size != m_buffer_size) {
+            m_split = splitSPITransfers(size, m_config, m_transfers.size());
+            m_buffer_size = size;
+        }
+        auto segment = std::begin(m_split.segments);
+        for (const auto segments : m_split.messages) {
+            for (std::size_t index = 0; index < segments; ++index, ++segment) {
+                auto& transfer = m_transfers[index];
+                std::memset(&transfer, 0, sizeof(transfer));
+                transfer.tx_buf = reinterpret_cast<__u64>(buffer.data() + segment->offset);
+                transfer.len = static_cast<__u32>(segment->length);
+                transfer.speed_hz = m_config.speed;
+                transfer.bits_per_word = 8;
+            }
+            if (ioctl(m_file_descriptor, SPI_IOC_MESSAGE(segments), m_transfers.data()) < 0) {
+                ioError("Could not write SPI packet");
+            }
         }
     }
 
@@ -60,7 +119,7 @@ namespace atmo {
             ioError(fmt::format("Could not open SPI device '{}'", m_filename));
         }
 
-        std::uint8_t mode{SPI_MODE_0};
+        std::uint8_t mode{m_config.mode};
         if (ioctl(m_file_descriptor, SPI_IOC_WR_MODE, &mode) < 0) {
             ioError("Could not set SPI write mode");
         }
@@ -78,7 +137,7 @@ namespace atmo {
             ioError("Could not set SPI read word length");
         }
 
-        std::uint32_t speed{500000};//8000000L
+        std::uint32_t speed{m_config.speed};
         if (ioctl(m_file_descriptor, SPI_IOC_WR_MAX_SPEED_HZ, &speed) < 0) {
             ioError("Could not set SPI write speed");
         }
@@ -98,38 +157,6 @@ namespace atmo {
         }
     }
 
-    DotStar::DotStar(const std::string& filename,
-                     std::size_t channels) :
-            SPIDevice{filename, channels} {}
-
-    auto computeDotStarBrightness(const Color& color) {
-        auto sum{0};
-        sum += color.red;
-        sum += color.blue;
-        sum += color.green;
-        auto intensity = sum / (3.0f * 255.0f);
-        return static_cast<unsigned char>(intensity * 31);
-    }
-
-    std::vector<unsigned char> DotStar::writeBuffer(gsl::span<const Color> channels) {
-        std::vector<unsigned char> buffer{};
-        buffer.resize(DOTSTAR_START_FRAME.size() + channels.size() * DOTSTAR_FRAME_LENGTH + DOTSTAR_END_FRAME.size());
-        auto current_position = std::copy(std::begin(DOTSTAR_START_FRAME),
-                                          std::end(DOTSTAR_START_FRAME),
-                                          std::begin(buffer));
-        for (const auto color : channels) {
-            unsigned char brightness = DOTSTAR_BRIGHTNESS | computeDotStarBrightness(color);
-            std::array<unsigned char, DOTSTAR_FRAME_LENGTH> frame{brightness, color.blue, color.green, color.red};
-            current_position = std::copy(std::begin(frame),
-                                         std::end(frame),
-                                         current_position);
-        }
-        std::copy(std::begin(DOTSTAR_END_FRAME),
-                  std::end(DOTSTAR_END_FRAME),
-                  current_position);
-        return buffer;
-    }
-
 }
 
 #endif
\ No newline at end of file
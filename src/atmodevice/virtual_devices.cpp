@@ -0,0 +1,206 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <atmo/virtual_devices.hpp>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace {
+
+    /**
+     * Seed of the simulated failures, fixed so load tests are repeatable.
+     */
+    constexpr std::mt19937::result_type FAILURE_SEED{5489U};
+
+    /**
+     * How long to wait for the reader of a named pipe once a frame has been written partially.
+     */
+    constexpr int FIFO_TIMEOUT_MS{1000};
+
+    void ioError(const std::string& error_message) {
+        const auto error = errno;
+        throw std::runtime_error{fmt::format("{}: {} {}",
+                                             error_message, error, std::strerror(error))};
+    }
+
+}
+
+namespace atmo {
+
+    VirtualAtmoDevice::VirtualAtmoDevice(std::size_t channels, const SimulationConfig& simulation) :
+            BaseAtmoDevice{channels},
+            m_simulation{simulation},
+            m_random{FAILURE_SEED},
+            m_failure{},
+            m_frames{0},
+            m_failures{0},
+            m_resets{0} {
+        if (!(m_simulation.failure_rate >= 0.0 && m_simulation.failure_rate <= 1.0)) {
+            throw std::runtime_error{fmt::format("Illegal failure rate: {}", m_simulation.failure_rate)};
+        }
+        if (m_simulation.write_latency.count() < 0) {
+            throw std::runtime_error{fmt::format("Illegal write latency: {}us", m_simulation.write_latency.count())};
+        }
+        m_failure = std::bernoulli_distribution{m_simulation.failure_rate};
+    }
+
+    void VirtualAtmoDevice::reset() {
+        ++m_resets;
+    }
+
+    std::uint64_t VirtualAtmoDevice::frames() const {
+        return m_frames;
+    }
+
+    std::uint64_t VirtualAtmoDevice::failures() const {
+        return m_failures;
+    }
+
+    std::uint64_t VirtualAtmoDevice::resets() const {
+        return m_resets;
+    }
+
+    void VirtualAtmoDevice::update(gsl::span<const Color> channels) {
+        if (m_simulation.write_latency.count() > 0) {
+            std::this_thread::sleep_for(m_simulation.write_latency);
+        }
+        if (m_failure(m_random)) {
+            ++m_failures;
+            throw std::runtime_error{"Simulated write failure"};
+        }
+        output(channels);
+        ++m_frames;
+    }
+
+    NullDevice::NullDevice(std::size_t channels, const SimulationConfig& simulation) :
+            VirtualAtmoDevice{channels, simulation} {}
+
+    void NullDevice::output(gsl::span<const Color>) {}
+
+    MemoryDevice::MemoryDevice(std::size_t channels, std::size_t capacity, const SimulationConfig& simulation) :
+            VirtualAtmoDevice{channels, simulation},
+            m_mutex{},
+            m_frames(capacity, std::vector<Color>(channels)),
+            m_next{0},
+            m_size{0} {
+        if (capacity == 0) {
+            throw std::runtime_error{"Illegal memory device capacity: 0"};
+        }
+    }
+
+    std::vector<std::vector<Color>> MemoryDevice::recordedFrames() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        std::vector<std::vector<Color>> frames{};
+        frames.reserve(m_size);
+        const auto first = m_next + m_frames.size() - m_size;
+        for (std::size_t frame = 0; frame < m_size; ++frame) {
+            frames.push_back(m_frames[(first + frame) % m_frames.size()]);
+        }
+        return frames;
+    }
+
+    void MemoryDevice::output(gsl::span<const Color> channels) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        std::copy(std::begin(channels), std::end(channels), std::begin(m_frames[m_next]));
+        m_next = (m_next + 1) % m_frames.size();
+        m_size = std::min(m_size + 1, m_frames.size());
+    }
+
+    FileDevice::FileDevice(const std::string& filename,
+                           std::size_t channels,
+                           FileType type,
+                           const SimulationConfig& simulation) :
+            VirtualAtmoDevice{channels, simulation},
+            m_filename{filename},
+            m_type{type},
+            m_file_descriptor{-1},
+            m_packet(channels * 3),
+            m_dropped_frames{0} {
+        openFile(true);
+    }
+
+    FileDevice::~FileDevice() {
+        closeFile();
+    }
+
+    void FileDevice::reset() {
+        VirtualAtmoDevice::reset();
+        closeFile();
+        // Keep the frames written so far, the reset must not discard the output of a recording.
+        openFile(false);
+    }
+
+    std::uint64_t FileDevice::droppedFrames() const {
+        return m_dropped_frames;
+    }
+
+    void FileDevice::openFile(bool truncate) {
+        if (m_type == FileType::Fifo) {
+            if (mkfifo(m_filename.c_str(), 0666) < 0 && errno != EEXIST) {
+                ioError(fmt::format("Could not create named pipe '{}'", m_filename));
+            }
+            // Opening for reading and writing neither blocks nor fails while there is no reader.
+            m_file_descriptor = open(m_filename.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        } else {
+            m_file_descriptor = open(m_filename.c_str(),
+                                     O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : O_APPEND),
+                                     0666);
+        }
+        if (m_file_descriptor < 0) {
+            ioError(fmt::format("Could not open file '{}'", m_filename));
+        }
+    }
+
+    void FileDevice::output(gsl::span<const Color> channels) {
+        auto* position = m_packet.data();
+        for (const auto color : channels) {
+            *position++ = color.red;
+            *position++ = color.green;
+            *position++ = color.blue;
+        }
+
+        std::size_t offset{0};
+        while (offset < m_packet.size()) {
+            const auto result = ::write(m_file_descriptor, m_packet.data() + offset, m_packet.size() - offset);
+            if (result >= 0) {
+                offset += static_cast<std::size_t>(result);
+            } else if (errno == EAGAIN && offset == 0) {
+                // The pipe is full, drop the frame instead of stalling the caller.
+                ++m_dropped_frames;
+                return;
+            } else if (errno == EAGAIN) {
+                // Complete the frame, so the reader stays in sync with the packet boundaries.
+                pollfd poll_fd{m_file_descriptor, POLLOUT, 0};
+                const auto ready = poll(&poll_fd, 1, FIFO_TIMEOUT_MS);
+                if (ready == 0) {
+                    throw std::runtime_error{fmt::format("Timeout writing to named pipe '{}'", m_filename)};
+                }
+                if (ready < 0 && errno != EINTR) {
+                    ioError(fmt::format("Could not wait for named pipe '{}'", m_filename));
+                }
+            } else if (errno != EINTR) {
+                ioError(fmt::format("Could not write to file '{}'", m_filename));
+            }
+        }
+    }
+
+    void FileDevice::closeFile() {
+        if (m_file_descriptor > -1) {
+            if (close(m_file_descriptor) < 0) {
+                const auto error = errno;
+                spdlog::error("Could not close file '{}': {} {}", m_filename, error, std::strerror(error));
+            }
+            m_file_descriptor = -1;
+        }
+    }
+
+}
@@ -5,7 +5,479 @@
 #define BOOST_TEST_MODULE test_analyzer
 
 #include <boost/test/included/unit_test.hpp>
+#include <deque>
+#include <thread>
+#include <atmo/border_analyzer.hpp>
+#include <atmo/frame_scheduler.hpp>
+#include <atmo/devices.hpp>
+#include <atmo/latest_queue.hpp>
+#include <atmo/mapping_table.hpp>
+#include <atmo/smoother.hpp>
+#include <atmo/v4l2_capture.hpp>
+#include <atmo/virtual_devices.hpp>
+#include "test_support.hpp"
+
+using namespace atmo;
+using namespace atmo::test;
+using namespace std::chrono_literals;
 
 BOOST_AUTO_TEST_CASE(first_test) {
 
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(frame_scheduler_keeps_absolute_deadlines) {
+    FrameScheduler scheduler{25.0};
+    const FrameScheduler::Clock::time_point start{};
+    scheduler.start(start);
+
+    BOOST_TEST((scheduler.next(start + 10ms, true) == start + 40ms));
+    BOOST_TEST((scheduler.next(start + 55ms, true) == start + 80ms));
+    BOOST_TEST(scheduler.statistics().frames == 2U);
+    BOOST_TEST(scheduler.statistics().dropped == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(frame_scheduler_drops_missed_frames) {
+    FrameScheduler scheduler{25.0};
+    const FrameScheduler::Clock::time_point start{};
+    scheduler.start(start);
+
+    // Processing took 130ms: the slots at 40ms and 80ms have been missed completely.
+    BOOST_TEST((scheduler.next(start + 130ms, true) == start + 120ms));
+    BOOST_TEST(scheduler.statistics().dropped == 2U);
+    BOOST_TEST((scheduler.next(start + 130ms, true) == start + 160ms));
+    BOOST_TEST(scheduler.statistics().dropped == 2U);
+}
+
+BOOST_AUTO_TEST_CASE(frame_scheduler_unpaced_backs_off_without_frames) {
+    FrameScheduler scheduler{0.0};
+    const FrameScheduler::Clock::time_point start{};
+    scheduler.start(start);
+
+    BOOST_TEST(!scheduler.paced());
+    BOOST_TEST((scheduler.next(start + 5ms, true) == start + 5ms));
+    BOOST_TEST((scheduler.next(start + 5ms, false) == start + 5ms + FrameScheduler::IDLE_INTERVAL));
+    BOOST_TEST(scheduler.statistics().frames == 1U);
+    BOOST_TEST(scheduler.statistics().empty == 1U);
+}
+
+BOOST_AUTO_TEST_CASE(frame_scheduler_rejects_negative_frame_rate) {
+    BOOST_CHECK_THROW(FrameScheduler{-1.0}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(latest_queue_keeps_newest_value) {
+    LatestQueue<int> queue{};
+    BOOST_TEST(!queue.consume());
+
+    queue.back() = 1;
+    queue.publish();
+    queue.back() = 2;
+    queue.publish();
+    BOOST_TEST(queue.depth() == 1U);
+    BOOST_TEST(queue.published() == 2U);
+    BOOST_TEST(queue.dropped() == 1U);
+
+    BOOST_TEST(queue.consume());
+    BOOST_TEST(queue.front() == 2);
+    BOOST_TEST(queue.depth() == 0U);
+    BOOST_TEST(!queue.consume());
+    BOOST_TEST(!queue.waitAndConsume(1ms));
+}
+
+BOOST_AUTO_TEST_CASE(latest_queue_transfers_values_between_threads) {
+    constexpr int COUNT{100000};
+    LatestQueue<int> queue{-1};
+    std::thread producer{[&queue]() {
+        for (int i = 0; i < COUNT; ++i) {
+            queue.back() = i;
+            queue.publish();
+        }
+    }};
+
+    int last{-1};
+    bool ordered{true};
+    while (last < COUNT - 1) {
+        if (queue.waitAndConsume(100ms)) {
+            ordered = ordered && queue.front() > last;
+            last = queue.front();
+        }
+    }
+    producer.join();
+
+    BOOST_TEST(ordered);
+    BOOST_TEST(queue.published() == static_cast<std::uint64_t>(COUNT));
+}
+
+namespace {
+
+    ChannelConfigs mappingChannelConfigs() {
+        ChannelConfigs configs{};
+        configs.top.count = 2;
+        configs.bottom.count = 1;
+        configs.left.count = 0;
+        configs.right.count = 1;
+        return configs;
+    }
+
+    Mappings validMappings() {
+        Mappings mappings{};
+        mappings.top = {{1, 2}, {0, 0}};
+        mappings.bottom = {{1, 0}, {0, 1}};
+        mappings.right = {{0, 1}};
+        return mappings;
+    }
+
+    const std::vector<DeviceInfo> MAPPING_DEVICES{{"first", 2}, {"second", 3}};
+
+}
+
+BOOST_AUTO_TEST_CASE(mapping_table_scatters_channels_to_devices) {
+    const MappingTable table{validMappings(), mappingChannelConfigs(), MAPPING_DEVICES};
+    BOOST_TEST(table.inputs() == 4U);
+    BOOST_TEST(table.outputs() == 5U);
+
+    const std::vector<Color> inputs{{1, 1, 1}, {2, 2, 2}, {3, 3, 3}, {4, 4, 4}};
+    std::vector<Color> outputs(table.outputs(), Color{9, 9, 9});
+    table.apply(inputs, outputs);
+
+    const std::vector<int> expected{2, 4, 3, 9, 1};
+    for (std::size_t i = 0; i < outputs.size(); ++i) {
+        BOOST_TEST(outputs[i].red == expected[i]);
+    }
+    BOOST_TEST(table.deviceChannels(outputs, 0).size() == 2);
+    BOOST_TEST(table.deviceChannels(outputs, 1)[0].red == 3);
+}
+
+BOOST_AUTO_TEST_CASE(mapping_table_rejects_invalid_mappings) {
+    auto missing = validMappings();
+    missing.top.pop_back();
+    BOOST_CHECK_THROW((MappingTable{missing, mappingChannelConfigs(), MAPPING_DEVICES}), std::runtime_error);
+
+    auto device = validMappings();
+    device.bottom[0].device_index = 2;
+    BOOST_CHECK_THROW((MappingTable{device, mappingChannelConfigs(), MAPPING_DEVICES}), std::runtime_error);
+
+    auto channel = validMappings();
+    channel.right[0].device_channel = 2;
+    BOOST_CHECK_THROW((MappingTable{channel, mappingChannelConfigs(), MAPPING_DEVICES}), std::runtime_error);
+
+    const MappingTable table{validMappings(), mappingChannelConfigs(), MAPPING_DEVICES};
+    std::vector<Color> outputs(table.outputs());
+    BOOST_CHECK_THROW(table.apply(std::vector<Color>(3), outputs), std::runtime_error);
+}
+
+namespace {
+
+    /**
+     * An AtmoDevice that takes a fixed time per update and optionally fails.
+     */
+    class FakeDevice : public BaseAtmoDevice {
+    public:
+        FakeDevice(std::size_t channels, std::chrono::milliseconds delay, bool failing = false) :
+                BaseAtmoDevice{channels},
+                updates{0},
+                m_delay{delay},
+                m_failing{failing} {}
+
+        std::atomic<int> updates;
+
+        void reset() override {}
+
+    protected:
+        void update(gsl::span<const Color>) override {
+            std::this_thread::sleep_for(m_delay);
+            if (m_failing) {
+                throw std::runtime_error{"Device failure"};
+            }
+            ++updates;
+        }
+
+    private:
+        std::chrono::milliseconds m_delay;
+        bool m_failing;
+    };
+
+    /**
+     * An AtmoDevice whose first update fails, which counts the resets.
+     */
+    class RecoveringDevice : public BaseAtmoDevice {
+    public:
+        RecoveringDevice() :
+                BaseAtmoDevice{1},
+                failures{0},
+                resets{0} {}
+
+        std::atomic<int> failures;
+        std::atomic<int> resets;
+
+        void reset() override {
+            ++resets;
+        }
+
+    protected:
+        void update(gsl::span<const Color>) override {
+            if (failures == 0) {
+                ++failures;
+                throw std::runtime_error{"Device failure"};
+            }
+        }
+    };
+
+}
+
+BOOST_AUTO_TEST_CASE(devices_submit_without_waiting_for_slow_devices) {
+    auto slow = std::make_unique<FakeDevice>(2, 100ms);
+    auto failing = std::make_unique<FakeDevice>(2, 0ms, true);
+    auto fast = std::make_unique<FakeDevice>(2, 0ms);
+    auto* slow_device = slow.get();
+    auto* fast_device = fast.get();
+    std::vector<Device> atmo_devices{};
+    atmo_devices.push_back(Device{"slow", std::move(slow)});
+    atmo_devices.push_back(Device{"failing", std::move(failing)});
+    atmo_devices.push_back(Device{"fast", std::move(fast)});
+    Devices devices{std::move(atmo_devices)};
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint8_t frame = 1; frame <= 10; ++frame) {
+        const std::vector<Color> channels{{frame, frame, frame}, {frame, frame, frame}};
+        for (DeviceIndex device = 0; device < devices.size(); ++device) {
+            devices.submitChannels(device, channels);
+        }
+    }
+    BOOST_TEST((std::chrono::steady_clock::now() - start < 50ms));
+
+    // The slow device skips outdated colors and ends up with the newest ones, the others are not stalled by it.
+    BOOST_TEST(waitFor([fast_device]() { return fast_device->updates > 0; }));
+    BOOST_TEST(waitFor([&devices]() { return devices.getChannel(0, 1).red == 10; }));
+    BOOST_TEST(slow_device->updates < 10);
+    BOOST_TEST(devices.getChannel(2, 0).red == 10);
+}
+
+BOOST_AUTO_TEST_CASE(devices_clear_drops_pending_colors) {
+    auto slow = std::make_unique<FakeDevice>(1, 50ms);
+    std::vector<Device> atmo_devices{};
+    atmo_devices.push_back(Device{"slow", std::move(slow)});
+    Devices devices{std::move(atmo_devices)};
+
+    devices.submitChannels(0, std::vector<Color>{{1, 1, 1}});
+    devices.submitChannels(0, std::vector<Color>{{2, 2, 2}});
+    devices.clear();
+    std::this_thread::sleep_for(100ms);
+    BOOST_TEST(devices.getChannel(0, 0).red == 0);
+}
+
+BOOST_AUTO_TEST_CASE(devices_retry_without_blocking_other_callers) {
+    auto recovering = std::make_unique<RecoveringDevice>();
+    auto* recovering_device = recovering.get();
+    std::vector<Device> atmo_devices{};
+    atmo_devices.push_back(Device{"recovering", std::move(recovering), true});
+    Devices devices{std::move(atmo_devices)};
+
+    std::thread caller{[&devices]() { devices.setChannel(0, 0, Color{1, 1, 1}); }};
+    BOOST_TEST(waitFor([recovering_device]() { return recovering_device->failures > 0; }));
+
+    // The failed call waits for its retry without holding the device, so other calls are not stalled by it.
+    devices.getChannel(0, 0);
+    BOOST_TEST(recovering_device->resets == 0);
+
+    caller.join();
+    BOOST_TEST(recovering_device->resets == 1);
+    BOOST_TEST(devices.getChannel(0, 0).red == 1);
+}
+
+BOOST_AUTO_TEST_CASE(devices_reject_invalid_channels_without_reset) {
+    auto memory = std::make_unique<MemoryDevice>(4, 1);
+    auto* memory_device = memory.get();
+    std::vector<Device> atmo_devices{};
+    atmo_devices.push_back(Device{"memory", std::move(memory), true});
+    Devices devices{std::move(atmo_devices)};
+
+    // A retry would wait at least one second before resetting the device, invalid arguments are rejected at once.
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<Color> colors{{1, 1, 1}, {2, 2, 2}, {3, 3, 3}};
+    BOOST_CHECK_THROW(devices.setChannels(0, 2, colors), std::out_of_range);
+    BOOST_CHECK_THROW(devices.setChannels(0, 5, gsl::span<const Color>{}), std::out_of_range);
+    const std::vector<ChannelColor> channel_colors{{0, {1, 1, 1}}, {4, {2, 2, 2}}};
+    BOOST_CHECK_THROW(devices.setChannelColors(0, channel_colors), std::out_of_range);
+    BOOST_CHECK_THROW(devices.getChannel(0, 4), std::out_of_range);
+    BOOST_CHECK_THROW(devices.setChannel(0, 4, {1, 1, 1}), std::out_of_range);
+    BOOST_CHECK_THROW(devices.setChannels(0, std::vector<Color>(5)), std::out_of_range);
+    BOOST_TEST((std::chrono::steady_clock::now() - start < 1s));
+    BOOST_TEST(devices.getChannel(0, 0).red == 0);
+    BOOST_TEST(memory_device->resets() == 0U);
+
+    devices.setChannels(0, 1, colors);
+    BOOST_TEST(devices.getChannel(0, 3).red == 3);
+}
+
+namespace {
+
+    std::uint8_t smoothStep(double fps,
+                            std::chrono::milliseconds duration,
+                            std::chrono::milliseconds time_constant = 100ms) {
+        Smoother smoother{SmoothingConfig{time_constant, 0}};
+        const auto start = Smoother::Clock::time_point{};
+        std::vector<Color> channels(5);
+        smoother.apply(channels, start);
+        const std::chrono::duration<double> frame_interval{1.0 / fps};
+        const auto frames = static_cast<int>(std::lround(duration / frame_interval));
+        for (int frame = 1; frame <= frames; ++frame) {
+            std::fill(std::begin(channels), std::end(channels), Color{255, 255, 255});
+            const auto time = start + std::chrono::duration_cast<Smoother::Clock::duration>(frame * frame_interval);
+            smoother.apply(channels, time);
+        }
+        return channels[4].green;
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(smoother_disabled_keeps_channels) {
+    Smoother smoother{SmoothingConfig{}};
+    BOOST_TEST(!smoother.enabled());
+    std::vector<Color> channels{{1, 2, 3}};
+    smoother.apply(channels, Smoother::Clock::now());
+    channels[0] = {200, 200, 200};
+    smoother.apply(channels, Smoother::Clock::now());
+    BOOST_TEST(channels[0].red == 200);
+}
+
+BOOST_AUTO_TEST_CASE(smoother_is_independent_of_frame_rate) {
+    // After 2.5 time constants, a step has reached 1 - e^-2.5 = 92% of its height.
+    const auto at_24_fps = smoothStep(24.0, 250ms);
+    const auto at_60_fps = smoothStep(60.0, 250ms);
+    BOOST_TEST(std::abs(at_24_fps - at_60_fps) <= 2);
+    BOOST_TEST(std::abs(at_60_fps - 234) <= 2);
+}
+
+BOOST_AUTO_TEST_CASE(smoother_reaches_targets_with_large_time_constants) {
+    // At 240 fps, the weight of a frame is far below 1/128 for these time constants. Unclamped, the step would stall
+    // below its target or not move at all.
+    BOOST_TEST(smoothStep(240.0, 60s, 10s) == 255);
+    BOOST_TEST(smoothStep(240.0, 1s, 1000s) > 0);
+}
+
+BOOST_AUTO_TEST_CASE(smoother_bypasses_scene_cuts) {
+    Smoother smoother{SmoothingConfig{100ms, 64}};
+    const auto start = Smoother::Clock::time_point{};
+    std::vector<Color> channels(4, Color{10, 10, 10});
+    smoother.apply(channels, start);
+
+    std::fill(std::begin(channels), std::end(channels), Color{50, 50, 50});
+    smoother.apply(channels, start + 40ms);
+    BOOST_TEST(channels[0].red > 10);
+    BOOST_TEST(channels[0].red < 50);
+
+    std::fill(std::begin(channels), std::end(channels), Color{255, 255, 255});
+    smoother.apply(channels, start + 80ms);
+    BOOST_TEST(channels[0].red == 255);
+}
+
+#ifdef WITH_V4L2
+BOOST_AUTO_TEST_CASE(v4l2_capture_rejects_non_video_devices) {
+    BOOST_CHECK_THROW((V4L2Capture{"/dev/null", {}, {}}), std::runtime_error);
+    BOOST_CHECK_THROW((V4L2Capture{"/nonexistent/video0", {}, {}}), std::runtime_error);
+}
+
+namespace {
+
+    /**
+     * A V4L2Capture with buffers in memory instead of a device. The filled buffers are dequeued in order and the
+     * indices of the buffers that have been handed back are recorded.
+     */
+    class MemoryV4L2Capture : public V4L2Capture {
+    public:
+        MemoryV4L2Capture(const ImageView& format, std::vector<std::vector<std::uint8_t>>& buffers,
+                          const ChannelConfigs& channel_configs) :
+                V4L2Capture{format, captureBuffers(buffers), channel_configs},
+                filled{},
+                queued{} {}
+
+        std::deque<DequeuedBuffer> filled;
+        std::vector<std::uint32_t> queued;
+
+        void fill(std::uint32_t index, std::uint32_t bytes_used, bool error = false) {
+            filled.push_back(DequeuedBuffer{index, bytes_used, error});
+        }
+
+    protected:
+        std::optional<DequeuedBuffer> dequeueBuffer() override {
+            if (filled.empty()) {
+                return std::nullopt;
+            }
+            const auto buffer = filled.front();
+            filled.pop_front();
+            return buffer;
+        }
+
+        void queueBuffer(std::uint32_t index) override {
+            queued.push_back(index);
+        }
+
+    private:
+        static std::vector<Buffer> captureBuffers(std::vector<std::vector<std::uint8_t>>& buffers) {
+            std::vector<Buffer> capture_buffers{};
+            for (auto& buffer : buffers) {
+                capture_buffers.push_back(Buffer{buffer.data(), buffer.size()});
+            }
+            return capture_buffers;
+        }
+    };
+
+}
+
+BOOST_AUTO_TEST_CASE(v4l2_capture_analyzes_nv12_buffers_in_place) {
+    // The rows are padded, so the chroma plane starts at stride * height rather than width * height.
+    constexpr int width{16};
+    constexpr int height{8};
+    constexpr std::size_t stride{24};
+    constexpr std::size_t frame_size{stride * height + stride * height / 2};
+    ImageView format{nullptr, width, height, stride, PixelFormat::NV12};
+    format.chroma_stride = stride;
+    ChannelConfigs configs{};
+    configs.top = {2, 2, 0};
+    configs.bottom = {2, 2, 0};
+    configs.left = {1, 2, 0};
+    configs.right = {1, 2, 0};
+
+    // Luma 200 and a reddish chroma, which differs from the luma read at a wrong chroma offset.
+    std::vector<std::vector<std::uint8_t>> buffers(2, std::vector<std::uint8_t>(frame_size, 200));
+    for (auto& buffer : buffers) {
+        for (std::size_t position = stride * height; position < frame_size; position += 2) {
+            buffer[position] = 90;
+            buffer[position + 1] = 240;
+        }
+    }
+    auto expected_image = format;
+    expected_image.data = buffers[0].data();
+    expected_image.chroma = buffers[0].data() + stride * height;
+    BorderAnalyzer analyzer{configs};
+    const auto expected = analyzer.analyze(expected_image);
+    BOOST_REQUIRE(expected.top()[0].red > expected.top()[0].blue);
+
+    MemoryV4L2Capture capture{format, buffers, configs};
+    capture.fill(1, frame_size);
+    capture.fill(0, frame_size - 1);
+    capture.fill(1, 0, true);
+    capture.fill(0, 0);
+
+    Channels channels{};
+    BOOST_TEST(capture.capture(channels));
+    BOOST_REQUIRE_EQUAL(channels.top().size(), expected.top().size());
+    for (std::ptrdiff_t channel = 0; channel < channels.top().size(); ++channel) {
+        BOOST_TEST(channels.top()[channel].red == expected.top()[channel].red);
+        BOOST_TEST(channels.top()[channel].green == expected.top()[channel].green);
+        BOOST_TEST(channels.top()[channel].blue == expected.top()[channel].blue);
+    }
+
+    // Incomplete and corrupted frames are skipped, the buffers are handed back nevertheless.
+    BOOST_TEST(!capture.capture(channels));
+    BOOST_TEST(!capture.capture(channels));
+    // A driver that does not report the used bytes delivers complete buffers.
+    BOOST_TEST(capture.capture(channels));
+    BOOST_TEST(!capture.capture(channels));
+    // A buffer that cannot be analyzed is handed back as well.
+    capture.fill(2, frame_size);
+    BOOST_CHECK_THROW(capture.capture(channels), std::out_of_range);
+    const std::vector<std::uint32_t> queued{1, 0, 1, 0, 2};
+    BOOST_TEST(capture.queued == queued, boost::test_tools::per_element());
+}
+#endif
@@ -0,0 +1,399 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <atmo/border_analyzer.hpp>
+
+using namespace atmo;
+
+namespace {
+
+    /**
+     * The number of heap allocations of the test process.
+     */
+    std::atomic<std::size_t> allocations{0};
+
+}
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (auto* memory = std::malloc(size > 0 ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+// GCC does not know that the replaced operator new allocates with malloc.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+    /**
+     * A regular grid of sampled pixels with its origin at (x, y).
+     */
+    struct Sampling {
+        int x{0};
+        int y{0};
+        int step_x{1};
+        int step_y{1};
+    };
+
+    struct TestImage {
+        int width;
+        int height;
+        PixelFormat format;
+        std::size_t stride;
+        std::vector<std::uint8_t> pixels;
+        std::vector<std::uint8_t> chroma;
+
+        TestImage(int width, int height, std::size_t padding, PixelFormat format = PixelFormat::BGR) :
+                width{width},
+                height{height},
+                format{format},
+                stride{static_cast<std::size_t>(width) * bytesPerPixel(format) + padding},
+                pixels(stride * height),
+                chroma(format == PixelFormat::NV12 ? stride * ((height + 1) / 2) : 0) {
+            std::mt19937 random{42};
+            std::uniform_int_distribution<int> distribution{0, 255};
+            for (auto* plane : {&pixels, &chroma}) {
+                for (auto& pixel : *plane) {
+                    pixel = static_cast<std::uint8_t>(distribution(random));
+                }
+            }
+        }
+
+        static std::size_t bytesPerPixel(PixelFormat format) {
+            switch (format) {
+                case PixelFormat::BGRA:
+                    return 4;
+                case PixelFormat::YUYV:
+                    return 2;
+                case PixelFormat::NV12:
+                    return 1;
+                default:
+                    return 3;
+            }
+        }
+
+        [[nodiscard]]
+        ImageView view() const {
+            ImageView view{pixels.data(), width, height, stride, format};
+            if (format == PixelFormat::NV12) {
+                view.chroma = chroma.data();
+                view.chroma_stride = stride;
+            }
+            return view;
+        }
+
+        /**
+         * Return the components of one pixel: R, G, B for RGB formats, Y, U, V for YUV formats.
+         */
+        [[nodiscard]]
+        std::array<int, 3> pixel(int x, int y) const {
+            const auto* row = pixels.data() + y * stride;
+            switch (format) {
+                case PixelFormat::BGR:
+                    return {row[x * 3 + 2], row[x * 3 + 1], row[x * 3]};
+                case PixelFormat::RGB:
+                    return {row[x * 3], row[x * 3 + 1], row[x * 3 + 2]};
+                case PixelFormat::BGRA:
+                    return {row[x * 4 + 2], row[x * 4 + 1], row[x * 4]};
+                case PixelFormat::YUYV:
+                    return {row[x * 2], row[x / 2 * 4 + 1], row[x / 2 * 4 + 3]};
+                case PixelFormat::NV12: {
+                    const auto* chroma_row = chroma.data() + y / 2 * stride;
+                    return {row[x], chroma_row[x / 2 * 2], chroma_row[x / 2 * 2 + 1]};
+                }
+            }
+            return {};
+        }
+
+        /**
+         * Reference implementation that averages one area pixel by pixel (like cv::mean on a BGR image). If a sampling
+         * grid is given, only the pixels on the grid are averaged.
+         */
+        [[nodiscard]]
+        Color mean(int x, int y, int area_width, int area_height, const Sampling& sampling = {}) const {
+            std::uint64_t sums[3]{0, 0, 0};
+            std::uint64_t count{0};
+            for (int row = y; row < y + area_height; ++row) {
+                for (int column = x; column < x + area_width; ++column) {
+                    if ((column - sampling.x) % sampling.step_x != 0 || (row - sampling.y) % sampling.step_y != 0) {
+                        continue;
+                    }
+                    const auto components = pixel(column, row);
+                    for (int component = 0; component < 3; ++component) {
+                        sums[component] += components[component];
+                    }
+                    ++count;
+                }
+            }
+            if (count == 0) {
+                return Color{};
+            }
+            const auto first = static_cast<std::uint8_t>(sums[0] / count);
+            const auto second = static_cast<std::uint8_t>(sums[1] / count);
+            const auto third = static_cast<std::uint8_t>(sums[2] / count);
+            if (format != PixelFormat::YUYV && format != PixelFormat::NV12) {
+                return Color{first, second, third};
+            }
+            const auto clamp = [](int value) { return static_cast<std::uint8_t>(std::clamp(value, 0, 255)); };
+            const auto c = first - 16;
+            const auto d = second - 128;
+            const auto e = third - 128;
+            return Color{clamp((298 * c + 409 * e + 128) >> 8),
+                         clamp((298 * c - 100 * d - 208 * e + 128) >> 8),
+                         clamp((298 * c + 516 * d + 128) >> 8)};
+        }
+    };
+
+    bool operator==(const Color& lhs, const Color& rhs) {
+        return lhs.red == rhs.red && lhs.green == rhs.green && lhs.blue == rhs.blue;
+    }
+
+    void checkEqual(gsl::span<const Color> actual, const std::vector<Color>& expected) {
+        BOOST_REQUIRE_EQUAL(static_cast<std::size_t>(actual.size()), expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            BOOST_TEST((actual[static_cast<std::ptrdiff_t>(i)] == expected[i]), "channel " << i << " differs");
+        }
+    }
+
+    /**
+     * The expected colors per area.
+     */
+    struct ReferenceChannels {
+        std::vector<Color> top{};
+        std::vector<Color> bottom{};
+        std::vector<Color> left{};
+        std::vector<Color> right{};
+    };
+
+    /**
+     * The sampling step along a side, limited to the length of one area.
+     */
+    int stepAlong(Width stride, float area_length) {
+        return std::clamp(static_cast<int>(stride), 1, std::max(1, static_cast<int>(area_length)));
+    }
+
+    ReferenceChannels referenceChannels(const TestImage& image, const ChannelConfigs& configs) {
+        ReferenceChannels channels{};
+        const auto width = static_cast<float>(image.width - configs.left.crop - configs.right.crop);
+        const auto height = static_cast<float>(image.height - configs.top.crop - configs.bottom.crop);
+        for (Channel channel = 0; channel < configs.top.count; ++channel) {
+            const auto area_width = width / configs.top.count;
+            const Sampling sampling{configs.left.crop,
+                                    configs.top.crop,
+                                    stepAlong(configs.top.stride_x, area_width),
+                                    configs.top.stride_y};
+            channels.top.push_back(image.mean(configs.left.crop + static_cast<Width>(area_width * channel),
+                                              configs.top.crop,
+                                              static_cast<Width>(area_width),
+                                              configs.top.depth,
+                                              sampling));
+        }
+        for (Channel channel = 0; channel < configs.bottom.count; ++channel) {
+            const auto area_width = width / configs.bottom.count;
+            const Sampling sampling{configs.left.crop,
+                                    image.height - configs.bottom.crop - configs.bottom.depth,
+                                    stepAlong(configs.bottom.stride_x, area_width),
+                                    configs.bottom.stride_y};
+            channels.bottom.push_back(image.mean(configs.left.crop + static_cast<Width>(area_width * channel),
+                                                 image.height - configs.bottom.crop - configs.bottom.depth,
+                                                 static_cast<Width>(area_width),
+                                                 configs.bottom.depth,
+                                                 sampling));
+        }
+        for (Channel channel = 0; channel < configs.left.count; ++channel) {
+            const auto area_height = height / configs.left.count;
+            const Sampling sampling{configs.left.crop,
+                                    configs.top.crop,
+                                    configs.left.stride_x,
+                                    stepAlong(configs.left.stride_y, area_height)};
+            channels.left.push_back(image.mean(configs.left.crop,
+                                               configs.top.crop + static_cast<Width>(area_height * channel),
+                                               configs.left.depth,
+                                               static_cast<Width>(area_height),
+                                               sampling));
+        }
+        for (Channel channel = 0; channel < configs.right.count; ++channel) {
+            const auto area_height = height / configs.right.count;
+            const Sampling sampling{image.width - configs.right.crop - configs.right.depth,
+                                    configs.top.crop,
+                                    configs.right.stride_x,
+                                    stepAlong(configs.right.stride_y, area_height)};
+            channels.right.push_back(image.mean(image.width - configs.right.crop - configs.right.depth,
+                                                configs.top.crop + static_cast<Width>(area_height * channel),
+                                                configs.right.depth,
+                                                static_cast<Width>(area_height),
+                                                sampling));
+        }
+        return channels;
+    }
+
+    void checkAgainstReference(const TestImage& image, const ChannelConfigs& configs) {
+        BorderAnalyzer analyzer{configs};
+        const auto actual = analyzer.analyze(image.view());
+        const auto expected = referenceChannels(image, configs);
+        checkEqual(actual.top(), expected.top);
+        checkEqual(actual.bottom(), expected.bottom);
+        checkEqual(actual.left(), expected.left);
+        checkEqual(actual.right(), expected.right);
+    }
+
+    ChannelConfigs oddChannelConfigs() {
+        ChannelConfigs configs{};
+        configs.top = {17, 12, 3};
+        configs.bottom = {13, 9, 5};
+        configs.left = {7, 21, 1};
+        configs.right = {11, 8, 0};
+        return configs;
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(border_analyzer_matches_per_area_mean) {
+    checkAgainstReference(TestImage{320, 180, 16}, oddChannelConfigs());
+}
+
+BOOST_AUTO_TEST_CASE(border_analyzer_supports_all_pixel_formats) {
+    for (const auto format : {PixelFormat::RGB, PixelFormat::BGRA, PixelFormat::YUYV, PixelFormat::NV12}) {
+        BOOST_TEST_CONTEXT("pixel format " << static_cast<int>(format)) {
+            checkAgainstReference(TestImage{321, 181, 5, format}, oddChannelConfigs());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(border_analyzer_handles_more_channels_than_pixels) {
+    const TestImage image{40, 30, 0};
+    ChannelConfigs configs{};
+    configs.top = {60, 4, 0};
+    configs.bottom = {1, 30, 0};
+    configs.left = {0, 4, 0};
+    configs.right = {45, 40, 0};
+    checkAgainstReference(image, configs);
+}
+
+BOOST_AUTO_TEST_CASE(border_analyzer_rejects_areas_outside_of_the_image) {
+    const TestImage image{40, 30, 0};
+    ChannelConfigs configs{};
+    configs.top = {1, 31, 0};
+    BorderAnalyzer analyzer{configs};
+    BOOST_CHECK_THROW(analyzer.analyze(image.view()), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(border_analyzer_samples_with_strides) {
+    auto configs = oddChannelConfigs();
+    configs.top.stride_x = 4;
+    configs.top.stride_y = 3;
+    configs.bottom.stride_x = 3;
+    configs.left.stride_x = 5;
+    configs.left.stride_y = 2;
+    configs.right.stride_y = 100;
+    for (const auto format : {PixelFormat::BGR, PixelFormat::BGRA, PixelFormat::YUYV, PixelFormat::NV12}) {
+        BOOST_TEST_CONTEXT("pixel format " << static_cast<int>(format)) {
+            checkAgainstReference(TestImage{321, 181, 5, format}, configs);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(border_analyzer_sampling_error_is_small_for_smooth_images) {
+    // A smooth 4K image, similar to the low frequency content at the borders of a video frame.
+    TestImage image{3840, 2160, 0};
+    for (int y = 0; y < image.height; ++y) {
+        for (int x = 0; x < image.width; ++x) {
+            for (int component = 0; component < 3; ++component) {
+                const auto value = 128.0 + 100.0 * std::sin(x / (97.0 + 31 * component)) * std::cos(y / 83.0);
+                image.pixels[y * image.stride + x * 3 + component] = static_cast<std::uint8_t>(value);
+            }
+        }
+    }
+    ChannelConfigs full{};
+    full.top = {60, 100, 0};
+    full.bottom = {60, 100, 0};
+    full.left = {34, 100, 0};
+    full.right = {34, 100, 0};
+
+    const auto expected = BorderAnalyzer{full}.analyze(image.view());
+    for (const Width stride : {2, 4, 8}) {
+        auto sampled = full;
+        for (auto* config : {&sampled.top, &sampled.bottom, &sampled.left, &sampled.right}) {
+            config->stride_x = stride;
+            config->stride_y = stride;
+        }
+        const auto actual = BorderAnalyzer{sampled}.analyze(image.view());
+        int max_error{0};
+        const auto lhs = actual.all();
+        const auto rhs = expected.all();
+        for (std::ptrdiff_t i = 0; i < lhs.size(); ++i) {
+            max_error = std::max({max_error,
+                                  std::abs(lhs[i].red - rhs[i].red),
+                                  std::abs(lhs[i].green - rhs[i].green),
+                                  std::abs(lhs[i].blue - rhs[i].blue)});
+        }
+        BOOST_TEST_MESSAGE("stride " << stride << ": " << stride * stride << "x fewer pixels, max error " << max_error);
+        // Less than 2% of the value range.
+        BOOST_TEST(max_error <= 4);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(border_analyzer_rebuilds_geometry_on_resolution_change) {
+    const auto configs = oddChannelConfigs();
+    BorderAnalyzer analyzer{configs};
+    Channels channels{};
+    for (const auto& image : {TestImage{320, 180, 0}, TestImage{320, 180, 0}, TestImage{641, 361, 3}}) {
+        const auto* storage = channels.all().data();
+        analyzer.analyze(image.view(), channels);
+        if (storage != nullptr) {
+            BOOST_TEST((channels.all().data() == storage), "channel storage has been reallocated");
+        }
+        const auto expected = referenceChannels(image, configs);
+        checkEqual(channels.top(), expected.top);
+        checkEqual(channels.bottom(), expected.bottom);
+        checkEqual(channels.left(), expected.left);
+        checkEqual(channels.right(), expected.right);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(border_analyzer_does_not_allocate_per_frame) {
+    auto configs = oddChannelConfigs();
+    configs.bottom.stride_x = 3;
+    configs.left.stride_x = 2;
+    for (const auto format : {PixelFormat::BGR, PixelFormat::YUYV, PixelFormat::NV12}) {
+        BOOST_TEST_CONTEXT("pixel format " << static_cast<int>(format)) {
+            const TestImage image{321, 181, 5, format};
+            BorderAnalyzer analyzer{configs};
+            Channels channels{};
+            // The first frame compiles the geometry and sizes all buffers.
+            analyzer.analyze(image.view(), channels);
+
+            const auto before = allocations.load();
+            for (int frame = 0; frame < 10; ++frame) {
+                analyzer.analyze(image.view(), channels);
+            }
+            BOOST_TEST(allocations.load() - before == 0U);
+        }
+    }
+}
@@ -0,0 +1,179 @@
+//
+// Created by Benedikt on 17.10.2026.
+//
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <atmo/devices.hpp>
+#include <atmo/virtual_devices.hpp>
+#include "channel_publisher.hpp"
+#include "request_handler.hpp"
+#include "test_support.hpp"
+
+using namespace atmo;
+using namespace atmo::test;
+
+namespace {
+
+    constexpr std::chrono::milliseconds PUSH_INTERVAL{10};
+
+    class TestSubscriber : public Subscriber {
+    public:
+        bool push(std::shared_ptr<const std::string> message) override {
+            messages.push_back(std::move(message));
+            return accept;
+        }
+
+        nlohmann::json message(std::size_t index) const {
+            return nlohmann::json::parse(*messages.at(index));
+        }
+
+        std::vector<std::shared_ptr<const std::string>> messages{};
+        bool accept{true};
+    };
+
+    void runFor(boost::asio::io_context& io_context, std::chrono::milliseconds duration) {
+        io_context.restart();
+        io_context.run_for(duration);
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(publisher_shares_serialized_frames) {
+    auto devices = createDevices(1, 4);
+    boost::asio::io_context io_context{};
+    ChannelPublisher publisher{devices, io_context, PUSH_INTERVAL};
+    const auto first = std::make_shared<TestSubscriber>();
+    const auto second = std::make_shared<TestSubscriber>();
+
+    publisher.subscribe(first, {});
+    publisher.subscribe(second, {});
+    runFor(io_context, 3 * PUSH_INTERVAL);
+
+    BOOST_REQUIRE_EQUAL(first->messages.size(), 1U);
+    BOOST_REQUIRE_EQUAL(second->messages.size(), 1U);
+    BOOST_TEST(first->messages[0] == second->messages[0]);
+    const auto message = first->message(0);
+    BOOST_TEST(message["event"].get<std::string>() == "channels");
+    BOOST_TEST(message["device"].get<int>() == 0);
+    BOOST_TEST(message["channels"].size() == 4U);
+}
+
+BOOST_AUTO_TEST_CASE(publisher_coalesces_changes) {
+    auto devices = createDevices(2, 4);
+    boost::asio::io_context io_context{};
+    ChannelPublisher publisher{devices, io_context, PUSH_INTERVAL};
+    const auto subscriber = std::make_shared<TestSubscriber>();
+    publisher.subscribe(subscriber, Subscription{{1}, false});
+    runFor(io_context, 3 * PUSH_INTERVAL);
+    BOOST_REQUIRE_EQUAL(subscriber->messages.size(), 1U);
+
+    for (std::uint8_t red = 1; red <= 50; ++red) {
+        devices.setChannel(1, 2, Color{red, 0, 0});
+        devices.setChannel(0, 2, Color{red, 0, 0});
+    }
+    runFor(io_context, 3 * PUSH_INTERVAL);
+
+    // Only the newest colors of the subscribed device are pushed.
+    BOOST_REQUIRE_EQUAL(subscriber->messages.size(), 2U);
+    const auto message = subscriber->message(1);
+    BOOST_TEST(message["device"].get<int>() == 1);
+    BOOST_TEST(message["channels"][2]["red"].get<int>() == 50);
+
+    // Unchanged colors are not pushed again.
+    devices.setChannel(1, 2, Color{50, 0, 0});
+    runFor(io_context, 3 * PUSH_INTERVAL);
+    BOOST_TEST(subscriber->messages.size() == 2U);
+}
+
+BOOST_AUTO_TEST_CASE(publisher_pushes_deltas) {
+    auto devices = createDevices(1, 8);
+    boost::asio::io_context io_context{};
+    ChannelPublisher publisher{devices, io_context, PUSH_INTERVAL};
+    const auto subscriber = std::make_shared<TestSubscriber>();
+    publisher.subscribe(subscriber, Subscription{{}, true});
+    runFor(io_context, 3 * PUSH_INTERVAL);
+
+    devices.setChannel(0, 3, Color{1, 2, 3});
+    devices.setChannel(0, 5, Color{4, 5, 6});
+    runFor(io_context, 3 * PUSH_INTERVAL);
+
+    BOOST_REQUIRE_EQUAL(subscriber->messages.size(), 2U);
+    BOOST_TEST(subscriber->message(0)["event"].get<std::string>() == "channels");
+    const auto delta = subscriber->message(1);
+    BOOST_TEST(delta["event"].get<std::string>() == "channel_delta");
+    BOOST_REQUIRE_EQUAL(delta["channels"].size(), 2U);
+    BOOST_TEST(delta["channels"][0]["channel"].get<int>() == 3);
+    BOOST_TEST(delta["channels"][1]["channel"].get<int>() == 5);
+    BOOST_TEST(delta["channels"][1]["blue"].get<int>() == 6);
+
+    // A dropped update is followed by all channels, so the subscriber can resynchronize.
+    subscriber->accept = false;
+    devices.setChannel(0, 0, Color{7, 7, 7});
+    runFor(io_context, 3 * PUSH_INTERVAL);
+    subscriber->accept = true;
+    devices.setChannel(0, 1, Color{8, 8, 8});
+    runFor(io_context, 3 * PUSH_INTERVAL);
+
+    BOOST_REQUIRE_EQUAL(subscriber->messages.size(), 4U);
+    const auto resynchronized = subscriber->message(3);
+    BOOST_TEST(resynchronized["event"].get<std::string>() == "channels");
+    BOOST_TEST(resynchronized["channels"][0]["red"].get<int>() == 7);
+    BOOST_TEST(resynchronized["channels"][1]["red"].get<int>() == 8);
+}
+
+BOOST_AUTO_TEST_CASE(subscribe_request) {
+    auto devices = createDevices(1, 2);
+    boost::asio::io_context io_context{};
+    ChannelPublisher publisher{devices, io_context, PUSH_INTERVAL};
+    RequestHandler request_handler{devices,
+                                   ModeCallbacks{
+                                           []() { return std::vector<Mode>{Mode::Control}; },
+                                           []() { return Mode::Control; },
+                                           [](Mode) {}},
+                                   &publisher};
+    const auto subscriber = std::make_shared<TestSubscriber>();
+
+    const auto parse = [](const std::optional<std::string>& response) { return nlohmann::json::parse(*response); };
+    BOOST_TEST(parse(request_handler.handleRequest(R"({"cmd": "subscribe", "msg_id": 1, "devices": [0]})",
+                                                   subscriber))["success"].get<bool>());
+    BOOST_TEST(!parse(request_handler.handleRequest(R"({"cmd": "subscribe", "msg_id": 2, "devices": [1]})",
+                                                    subscriber))["success"].get<bool>());
+    BOOST_TEST(!parse(request_handler.handleRequest(R"({"cmd": "subscribe", "msg_id": 3})"))["success"].get<bool>());
+    runFor(io_context, 3 * PUSH_INTERVAL);
+    BOOST_TEST(subscriber->messages.size() == 1U);
+
+    BOOST_TEST(parse(request_handler.handleRequest(R"({"cmd": "unsubscribe", "msg_id": 4})",
+                                                   subscriber))["success"].get<bool>());
+    devices.setChannel(0, 0, Color{1, 1, 1});
+    runFor(io_context, 3 * PUSH_INTERVAL);
+    BOOST_TEST(subscriber->messages.size() == 1U);
+}
+
+BOOST_AUTO_TEST_CASE(publisher_reads_untracked_colors_on_subscribe) {
+    auto devices = createDevices(1, 2);
+    boost::asio::io_context io_context{};
+    ChannelPublisher publisher{devices, io_context, PUSH_INTERVAL};
+
+    // Without subscribers, changes are not tracked and the current colors are read by the first subscription.
+    devices.setChannel(0, 1, Color{1, 2, 3});
+    const auto first = std::make_shared<TestSubscriber>();
+    publisher.subscribe(first, {});
+    runFor(io_context, 3 * PUSH_INTERVAL);
+    BOOST_REQUIRE_EQUAL(first->messages.size(), 1U);
+    BOOST_TEST(first->message(0)["channels"][1]["blue"].get<int>() == 3);
+
+    publisher.unsubscribe(first.get());
+    devices.setChannel(0, 1, Color{4, 5, 6});
+    const auto second = std::make_shared<TestSubscriber>();
+    publisher.subscribe(second, {});
+    runFor(io_context, 3 * PUSH_INTERVAL);
+    BOOST_REQUIRE_EQUAL(second->messages.size(), 1U);
+    BOOST_TEST(second->message(0)["channels"][1]["blue"].get<int>() == 6);
+    BOOST_TEST(first->messages.size() == 1U);
+}
@@ -0,0 +1,226 @@
+//
+// Created by Benedikt on 17.10.2026.
+//
+
+#include <boost/test/unit_test.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <atmo/control_server.hpp>
+#include <atmo/devices.hpp>
+#include <atmo/virtual_devices.hpp>
+#include "test_support.hpp"
+
+using namespace atmo;
+using namespace atmo::test;
+
+namespace {
+
+    namespace beast = boost::beast;
+    using tcp = boost::asio::ip::tcp;
+    using Latency = std::chrono::duration<double, std::milli>;
+
+    constexpr std::chrono::milliseconds SLOW_WRITE_LATENCY{50};
+
+    /**
+     * A blocking websocket client of the control server.
+     */
+    class Client {
+    public:
+        explicit Client(std::uint16_t port) :
+                m_io_context{},
+                m_stream{m_io_context},
+                m_buffer{} {
+            tcp::resolver resolver{m_io_context};
+            boost::asio::connect(m_stream.next_layer(), resolver.resolve("127.0.0.1", std::to_string(port)));
+            m_stream.next_layer().set_option(tcp::no_delay{true});
+            m_stream.handshake("127.0.0.1", "/");
+        }
+
+        nlohmann::json request(const std::string& request) {
+            send(request);
+            return receive();
+        }
+
+        void send(const std::string& request) {
+            m_stream.write(boost::asio::buffer(request));
+        }
+
+        nlohmann::json receive() {
+            m_stream.read(m_buffer);
+            auto response = nlohmann::json::parse(beast::buffers_to_string(m_buffer.cdata()));
+            m_buffer.consume(m_buffer.size());
+            return response;
+        }
+
+    private:
+        boost::asio::io_context m_io_context;
+        beast::websocket::stream<tcp::socket> m_stream;
+        beast::flat_buffer m_buffer;
+    };
+
+    Devices createFastAndSlowDevices() {
+        SimulationConfig slow{};
+        slow.write_latency = SLOW_WRITE_LATENCY;
+        std::vector<Device> devices{};
+        devices.push_back(Device{"fast", std::make_unique<MemoryDevice>(16, 1)});
+        devices.push_back(Device{"slow", std::make_unique<NullDevice>(16, slow)});
+        return Devices{std::move(devices)};
+    }
+
+    std::string setChannelRequest(int msg_id, DeviceIndex device, std::uint8_t red, bool ack) {
+        return fmt::format(R"({{"cmd": "set_channel", "msg_id": {}, "ack": {}, "device": {}, "channel": 0,)"
+                           R"( "red": {}, "green": 0, "blue": 0}})", msg_id, ack, device, red);
+    }
+
+    Latency percentile(const std::vector<Latency>& sorted, double percentile) {
+        const auto index = static_cast<std::size_t>(percentile / 100.0 * static_cast<double>(sorted.size() - 1));
+        return sorted[index];
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(control_server_latency_with_concurrent_clients) {
+    constexpr int clients{50};
+    constexpr int requests{40};
+    auto devices = createFastAndSlowDevices();
+    ControlServer server{devices,
+                         controlModeCallbacks(),
+                         "127.0.0.1",
+                         0,
+                         std::chrono::milliseconds{33},
+                         2,
+                         4};
+
+    // One client keeps the slow device busy, which must not delay the requests of the other clients.
+    // Boost.Test assertions are not thread safe, so the clients only count failed requests.
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+    std::atomic<int> slow_requests{0};
+    std::thread slow_client{[&]() {
+        Client client{server.port()};
+        while (!done) {
+            // Alternate the color, unchanged colors would not be written to the device.
+            const auto red = static_cast<std::uint8_t>(slow_requests % 2 + 1);
+            if (!client.request(setChannelRequest(1, 1, red, true))["success"].get<bool>()) {
+                ++failures;
+            }
+            ++slow_requests;
+        }
+    }};
+    while (slow_requests == 0) {
+        std::this_thread::yield();
+    }
+
+    std::mutex mutex{};
+    std::vector<Latency> latencies{};
+    std::vector<std::thread> threads{};
+    for (int thread = 0; thread < clients; ++thread) {
+        threads.emplace_back([&, thread]() {
+            Client client{server.port()};
+            std::vector<Latency> client_latencies{};
+            for (int request = 0; request < requests; ++request) {
+                const auto start = std::chrono::steady_clock::now();
+                const auto response = client.request(fmt::format(
+                        R"({{"cmd": "set_channel", "msg_id": {}, "device": 0, "channel": {},)"
+                        R"( "red": 1, "green": 2, "blue": 3}})", request, thread % 16));
+                client_latencies.push_back(std::chrono::steady_clock::now() - start);
+                if (!response["success"].get<bool>()) {
+                    ++failures;
+                }
+            }
+            std::lock_guard<std::mutex> lock{mutex};
+            latencies.insert(std::end(latencies), std::begin(client_latencies), std::end(client_latencies));
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    slow_client.join();
+    BOOST_TEST(slow_requests > 1);
+
+    BOOST_TEST(failures == 0);
+    BOOST_REQUIRE_EQUAL(latencies.size(), static_cast<std::size_t>(clients * requests));
+    std::sort(std::begin(latencies), std::end(latencies));
+    BOOST_TEST_MESSAGE(clients << " clients, " << requests << " requests each: p50 "
+                               << percentile(latencies, 50).count() << "ms, p90 "
+                               << percentile(latencies, 90).count() << "ms, p99 "
+                               << percentile(latencies, 99).count() << "ms, max "
+                               << latencies.back().count() << "ms");
+    // Requests that waited for the slow device would take about SLOW_WRITE_LATENCY. The margin is large, so only
+    // serialized requests fail this check, not a loaded machine.
+    BOOST_TEST((percentile(latencies, 50) < Latency{SLOW_WRITE_LATENCY} / 5));
+}
+
+BOOST_AUTO_TEST_CASE(control_server_pipelines_requests) {
+    constexpr int requests{2000};
+    constexpr int window{16};
+    auto devices = createFastAndSlowDevices();
+    ControlServer server{devices,
+                         controlModeCallbacks(),
+                         "127.0.0.1",
+                         0,
+                         std::chrono::milliseconds{33},
+                         2,
+                         4};
+    Client client{server.port()};
+
+    const auto measure = [](auto&& run) {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        return requests / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    int failures{0};
+    const auto sequential_rate = measure([&]() {
+        for (int request = 0; request < requests; ++request) {
+            failures += !client.request(setChannelRequest(request, 0, 1, true))["success"].get<bool>();
+        }
+    });
+
+    // Send a window of requests before reading their responses, which are returned in order of the requests.
+    int unordered{0};
+    const auto pipelined_rate = measure([&]() {
+        for (int first = 0; first < requests; first += window) {
+            for (int request = first; request < first + window; ++request) {
+                client.send(setChannelRequest(request, 0, 2, true));
+            }
+            for (int request = first; request < first + window; ++request) {
+                const auto response = client.receive();
+                failures += !response["success"].get<bool>();
+                unordered += response["msg_id"].get<int>() != request;
+            }
+        }
+    });
+
+    // Only the last request is acknowledged, which confirms the preceding ones.
+    const auto unacknowledged_rate = measure([&]() {
+        for (int request = 0; request < requests - 1; ++request) {
+            client.send(setChannelRequest(request, 0, 3, false));
+        }
+        const auto response = client.request(setChannelRequest(requests, 0, 4, true));
+        failures += !response["success"].get<bool>();
+        unordered += response["msg_id"].get<int>() != requests;
+    });
+
+    // Failed requests are answered, even if they are not acknowledged.
+    client.send(setChannelRequest(1, 2, 5, false));
+    client.send(setChannelRequest(2, 0, 5, true));
+    BOOST_TEST(client.receive()["msg_id"].get<int>() == 1);
+    BOOST_TEST(client.receive()["msg_id"].get<int>() == 2);
+
+    BOOST_TEST_MESSAGE("set_channel: " << sequential_rate << " sequential requests/s, " << pipelined_rate
+                                       << " pipelined requests/s, " << unacknowledged_rate
+                                       << " unacknowledged requests/s");
+    BOOST_TEST(failures == 0);
+    BOOST_TEST(unordered == 0);
+    BOOST_TEST(devices.getChannels(0)[0].red == 5);
+}
@@ -0,0 +1,102 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <atmo/pixel_kernels.hpp>
+
+using namespace atmo;
+
+namespace {
+
+    std::vector<std::uint8_t> randomBytes(std::size_t count) {
+        std::mt19937 random{7};
+        std::uniform_int_distribution<int> distribution{0, 255};
+        std::vector<std::uint8_t> bytes(count);
+        for (auto& byte : bytes) {
+            byte = static_cast<std::uint8_t>(distribution(random));
+        }
+        return bytes;
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(pixel_kernels_start_with_scalar) {
+    const auto kernels = supportedPixelKernels();
+    BOOST_REQUIRE(!kernels.empty());
+    BOOST_TEST(std::string{kernels.front()->name} == "scalar");
+    BOOST_TEST_MESSAGE("Selected pixel kernels: " << pixelKernels().name);
+}
+
+BOOST_AUTO_TEST_CASE(pixel_kernels_accumulate_like_scalar) {
+    const auto bytes = randomBytes(1024);
+    const auto& scalar = *supportedPixelKernels().front();
+    for (const auto* kernels : supportedPixelKernels()) {
+        for (const std::size_t offset : {0, 1, 3}) {
+            for (std::size_t count = 0; count < 200; ++count) {
+                std::vector<std::uint32_t> expected(count, 1000);
+                std::vector<std::uint32_t> actual(count, 1000);
+                for (int row = 0; row < 3; ++row) {
+                    scalar.accumulate(bytes.data() + offset + row * 211, count, expected.data());
+                    kernels->accumulate(bytes.data() + offset + row * 211, count, actual.data());
+                }
+                BOOST_TEST(actual == expected, kernels->name << ": count " << count << ", offset " << offset);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pixel_kernels_sum_interleaved_like_scalar) {
+    const auto bytes = randomBytes(1024);
+    const auto& scalar = *supportedPixelKernels().front();
+    for (const auto* kernels : supportedPixelKernels()) {
+        for (std::size_t components = 1; components <= 4; ++components) {
+            for (std::size_t count = 0; count < 400; count += components) {
+                std::uint32_t expected[4]{1, 2, 3, 4};
+                std::uint32_t actual[4]{1, 2, 3, 4};
+                scalar.sumInterleaved(bytes.data() + 5, count, components, expected);
+                kernels->sumInterleaved(bytes.data() + 5, count, components, actual);
+                BOOST_TEST(std::vector<std::uint32_t>(actual, actual + 4) ==
+                           std::vector<std::uint32_t>(expected, expected + 4),
+                           kernels->name << ": " << components << " components, count " << count);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pixel_kernels_smooth_like_scalar) {
+    const auto bytes = randomBytes(1024);
+    const auto& scalar = *supportedPixelKernels().front();
+    for (const auto* kernels : supportedPixelKernels()) {
+        for (const std::int16_t weight : {0, 1, 1000, 16384, 32767}) {
+            for (std::size_t count = 0; count < 100; ++count) {
+                std::vector<std::int16_t> expected_state(count, 0);
+                std::vector<std::int16_t> actual_state(count, 0);
+                std::vector<std::uint8_t> expected(count);
+                std::vector<std::uint8_t> actual(count);
+                for (int frame = 0; frame < 4; ++frame) {
+                    scalar.smooth(bytes.data() + frame * 211, count, weight, expected_state.data(), expected.data());
+                    kernels->smooth(bytes.data() + frame * 211, count, weight, actual_state.data(), actual.data());
+                }
+                BOOST_TEST(actual_state == expected_state, kernels->name << ": weight " << weight
+                                                                         << ", count " << count);
+                BOOST_TEST(actual == expected, kernels->name << ": weight " << weight << ", count " << count);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pixel_kernels_smooth_converges) {
+    for (const auto* kernels : supportedPixelKernels()) {
+        std::vector<std::int16_t> state(32, 0);
+        std::vector<std::uint8_t> bytes(32, 255);
+        std::vector<std::uint8_t> smoothed(32);
+        kernels->smooth(bytes.data(), bytes.size(), 16384, state.data(), smoothed.data());
+        BOOST_TEST(smoothed[17] == 128, kernels->name);
+        for (int frame = 0; frame < 30; ++frame) {
+            kernels->smooth(bytes.data(), bytes.size(), 16384, state.data(), smoothed.data());
+        }
+        BOOST_TEST(smoothed[31] == 255, kernels->name);
+    }
+}
@@ -0,0 +1,254 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <atmo/devices.hpp>
+#include <atmo/virtual_devices.hpp>
+#include "request_handler.hpp"
+#include "request_parser.hpp"
+#include "test_support.hpp"
+
+using namespace atmo;
+using namespace atmo::test;
+
+namespace {
+
+    std::vector<unsigned char> binaryRequest(DeviceIndex device, Channel first, const std::vector<Color>& colors) {
+        std::vector<unsigned char> request{SetChannelsBinaryRequest::TYPE,
+                                           static_cast<unsigned char>(device >> 8),
+                                           static_cast<unsigned char>(device),
+                                           static_cast<unsigned char>(first >> 8),
+                                           static_cast<unsigned char>(first),
+                                           static_cast<unsigned char>(colors.size() >> 8),
+                                           static_cast<unsigned char>(colors.size())};
+        for (const auto& color : colors) {
+            request.insert(std::end(request), {color.red, color.green, color.blue});
+        }
+        return request;
+    }
+
+    std::string jsonRequest(DeviceIndex device, const std::vector<Color>& colors) {
+        nlohmann::json request{};
+        request["cmd"] = "set_channels";
+        request["msg_id"] = 1;
+        request["device"] = device;
+        auto& channels = request["channels"];
+        channels = nlohmann::json::array();
+        for (const auto& color : colors) {
+            channels.push_back({{"red", color.red}, {"green", color.green}, {"blue", color.blue}});
+        }
+        return request.dump();
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(binary_request_sets_channel_range) {
+    auto devices = createDevices(1, 8);
+    RequestHandler request_handler{devices, controlModeCallbacks()};
+
+    const auto colors = testColors(3, 7);
+    const auto request = binaryRequest(0, 4, colors);
+    BOOST_TEST(!request_handler.handleBinaryRequest(request).has_value());
+
+    const auto channels = devices.getChannels(0);
+    for (std::size_t channel = 0; channel < channels.size(); ++channel) {
+        const auto expected = channel >= 4 && channel < 7 ? colors[channel - 4] : Color{};
+        BOOST_TEST(channels[channel].red == expected.red);
+        BOOST_TEST(channels[channel].green == expected.green);
+        BOOST_TEST(channels[channel].blue == expected.blue);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(binary_request_reports_errors) {
+    auto devices = createDevices(1, 8);
+    RequestHandler request_handler{devices, controlModeCallbacks()};
+
+    auto wrong_type = binaryRequest(0, 0, testColors(1, 0));
+    wrong_type[0] = 0x7F;
+    auto truncated = binaryRequest(0, 0, testColors(2, 0));
+    truncated.pop_back();
+    const std::vector<std::vector<unsigned char>> requests{
+            {SetChannelsBinaryRequest::TYPE, 0, 0},
+            wrong_type,
+            truncated,
+            binaryRequest(1, 0, testColors(1, 0)),
+            binaryRequest(0, 6, testColors(3, 0))};
+
+    for (const auto& request : requests) {
+        const auto response = request_handler.handleBinaryRequest(request);
+        BOOST_REQUIRE(response.has_value());
+        const auto json = nlohmann::json::parse(*response);
+        BOOST_TEST(json["success"].get<bool>() == false);
+        BOOST_TEST(json["msg_id"].get<int>() == -1);
+    }
+    BOOST_TEST(devices.getChannels(0)[6].red == 0);
+}
+
+BOOST_AUTO_TEST_CASE(request_without_acknowledgement) {
+    auto devices = createDevices(1, 2);
+    RequestHandler request_handler{devices, controlModeCallbacks()};
+
+    BOOST_TEST(!request_handler.handleRequest(
+            R"({"cmd": "set_channel", "msg_id": 1, "ack": false, "device": 0, "channel": 1, "red": 5, "green": 0,)"
+            R"( "blue": 0})").has_value());
+    BOOST_TEST(devices.getChannels(0)[1].red == 5);
+
+    // Failed requests are answered anyway.
+    const auto failed = request_handler.handleRequest(
+            R"({"cmd": "set_channel", "msg_id": 2, "ack": false, "device": 1, "channel": 0, "red": 5, "green": 0,)"
+            R"( "blue": 0})");
+    BOOST_REQUIRE(failed.has_value());
+    BOOST_TEST(nlohmann::json::parse(*failed)["msg_id"].get<int>() == 2);
+    BOOST_TEST(nlohmann::json::parse(*failed)["success"].get<bool>() == false);
+
+    const auto malformed = request_handler.handleRequest(R"({"cmd": "get_mode", "msg_id": 3, "ack": 1})");
+    BOOST_REQUIRE(malformed.has_value());
+    BOOST_TEST(nlohmann::json::parse(*malformed)["success"].get<bool>() == false);
+}
+
+BOOST_AUTO_TEST_CASE(request_parser_decodes_channel_requests) {
+    RequestParser parser{};
+    BOOST_REQUIRE(parser.parse(R"({"device": 2, "channels": [{"red": 1, "green": 2, "blue": 3, "unknown": [{}]},)"
+                               R"( {"blue": 6, "green": 5, "red": 4}], "msg_id": -7, "cmd": "set_channels"})"));
+    BOOST_TEST((parser.command() == RequestParser::Command::SetChannels));
+    BOOST_TEST(parser.msgId() == -7);
+    BOOST_TEST(parser.ack());
+    BOOST_TEST(parser.device() == 2U);
+    BOOST_REQUIRE_EQUAL(parser.colors().size(), 2);
+    BOOST_TEST(parser.colors()[1].red == 4);
+    BOOST_TEST(parser.colors()[1].blue == 6);
+
+    BOOST_REQUIRE(parser.parse(R"({"cmd": "set_channel", "msg_id": 1, "ack": false, "device": 0, "channels":)"
+                               R"( [{"channel": 9, "red": 1, "green": 2, "blue": 3}]})"));
+    BOOST_TEST(!parser.ack());
+    BOOST_REQUIRE_EQUAL(parser.channelColors().size(), 1);
+    BOOST_TEST(parser.channelColors()[0].channel == 9U);
+    BOOST_TEST(parser.channelColors()[0].color.green == 2);
+
+    BOOST_REQUIRE(parser.parse(R"({"cmd": "set_channel", "msg_id": 1, "device": 0, "channel": 4, "red": 1,)"
+                               R"( "green": 2, "blue": 3, "comment": "unused"})"));
+    BOOST_REQUIRE_EQUAL(parser.channelColors().size(), 1);
+    BOOST_TEST(parser.channelColors()[0].channel == 4U);
+
+    // Everything else is left to the generic request classes.
+    const std::vector<std::string> rejected{
+            R"({"cmd": "get_devices", "msg_id": 1})",
+            R"({"cmd": "get_channels", "msg_id": 1})",
+            R"({"cmd": "get_channels", "device": 0})",
+            R"({"cmd": "get_channels", "msg_id": 1, "device": 0.0})",
+            R"({"cmd": "get_channels", "msg_id": 1, "device": 0, "ack": 1})",
+            R"({"cmd": "set_channel", "msg_id": 1, "device": 0, "channel": 4, "red": 1, "green": 2})",
+            R"({"cmd": "set_channel", "msg_id": 1, "device": 0, "channels": [{"red": 1, "green": 2, "blue": 3}]})",
+            R"({"cmd": "set_channels", "msg_id": 1, "device": 0, "channels": [{"red": 256, "green": 2, "blue": 3}]})",
+            R"({"cmd": "set_channels", "msg_id": 1, "device": 0, "channels": [[1, 2, 3]]})",
+            R"({"cmd": "set_channels", "msg_id": 1, "device": 0})",
+            R"({"cmd": "get_channels", "msg_id": 1, "device": 0)",
+            R"([{"cmd": "get_channels", "msg_id": 1, "device": 0}])"};
+    for (const auto& request : rejected) {
+        BOOST_TEST(!parser.parse(request), request);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(channel_requests_match_generic_requests) {
+    auto devices = createDevices(1, 4);
+    RequestHandler request_handler{devices, controlModeCallbacks()};
+
+    // The generic request classes accept floating point numbers as indices, while the request parser rejects them.
+    const std::vector<std::string> requests{
+            R"({"cmd": "set_channels", "msg_id": 1, "device": DEVICE, "channels": [{"red": 1, "green": 2, "blue": 3},)"
+            R"( {"red": 4, "green": 5, "blue": 6}]})",
+            R"({"cmd": "set_channel", "msg_id": 2, "device": DEVICE, "channel": 2, "red": 7, "green": 8, "blue": 9})",
+            R"({"cmd": "set_channel", "msg_id": 3, "device": DEVICE, "channels": [{"channel": 3, "red": 10,)"
+            R"( "green": 11, "blue": 12}]})",
+            R"({"cmd": "get_channels", "msg_id": 4, "device": DEVICE})",
+            R"({"cmd": "get_channels", "msg_id": 5, "device": DEVICE, "ack": false})",
+            R"({"cmd": "set_channel", "msg_id": 6, "device": DEVICE, "channel": 4, "red": 1, "green": 2, "blue": 3})",
+            R"({"cmd": "get_channels", "msg_id": 7, "device": INVALID})"};
+
+    const auto replace = [](std::string request, const std::string& placeholder, const std::string& value) {
+        const auto position = request.find(placeholder);
+        return position == std::string::npos ? request : request.replace(position, placeholder.size(), value);
+    };
+    for (const auto& request : requests) {
+        const auto decoded = request_handler.handleRequest(replace(replace(request, "DEVICE", "0"), "INVALID", "1"));
+        const auto generic = request_handler.handleRequest(replace(replace(request, "DEVICE", "0.0"), "INVALID",
+                                                                   "1.0"));
+        BOOST_TEST(decoded.has_value() == generic.has_value(), request);
+        BOOST_TEST(decoded.value_or("") == generic.value_or(""), request);
+    }
+
+    const auto channels = devices.getChannels(0);
+    BOOST_TEST(channels[1].blue == 6);
+    BOOST_TEST(channels[2].red == 7);
+    BOOST_TEST(channels[3].green == 11);
+}
+
+BOOST_AUTO_TEST_CASE(binary_request_throughput) {
+    constexpr std::size_t channels{300};
+    constexpr int messages{2000};
+    auto devices = createDevices(1, channels);
+    RequestHandler request_handler{devices, controlModeCallbacks()};
+
+    std::vector<std::string> json_requests{};
+    std::vector<std::vector<unsigned char>> binary_requests{};
+    for (std::uint8_t seed = 0; seed < 2; ++seed) {
+        json_requests.push_back(jsonRequest(0, testColors(channels, seed)));
+        binary_requests.push_back(binaryRequest(0, 0, testColors(channels, seed)));
+    }
+
+    const auto measure = [](auto&& handle) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int message = 0; message < messages; ++message) {
+            handle(message % 2);
+        }
+        return messages / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    int json_failures{0};
+    const auto json_rate = measure([&](int index) {
+        const auto response = request_handler.handleRequest(json_requests[index]);
+        json_failures += !nlohmann::json::parse(*response)["success"].get<bool>();
+    });
+    BOOST_TEST(json_failures == 0);
+    BOOST_TEST(devices.getChannels(0)[1].red == 2);
+
+    devices.setChannels(0, testColors(channels, 0));
+    int binary_failures{0};
+    const auto binary_rate = measure([&](int index) {
+        binary_failures += request_handler.handleBinaryRequest(binary_requests[index]).has_value();
+    });
+    BOOST_TEST(binary_failures == 0);
+    BOOST_TEST(devices.getChannels(0)[1].red == 2);
+
+    // The rates depend on the machine, so they are only reported.
+    BOOST_TEST_MESSAGE("set_channels of " << channels << " channels: " << json_rate << " JSON messages/s, "
+                                          << binary_rate << " binary messages/s");
+}
+
+BOOST_AUTO_TEST_CASE(json_request_throughput) {
+    constexpr std::size_t channels{300};
+    constexpr int messages{2000};
+    auto devices = createDevices(1, channels);
+    RequestHandler request_handler{devices, controlModeCallbacks()};
+
+    const std::vector<std::pair<std::string, std::string>> requests{
+            {"set_channel",
+             R"({"cmd": "set_channel", "msg_id": 1, "device": 0, "channel": 7, "red": 1, "green": 2, "blue": 3})"},
+            {"set_channels", jsonRequest(0, testColors(channels, 1))},
+            {"get_channels", R"({"cmd": "get_channels", "msg_id": 1, "device": 0})"}};
+
+    for (const auto& [command, request] : requests) {
+        BOOST_REQUIRE(nlohmann::json::parse(*request_handler.handleRequest(request))["success"].get<bool>());
+        const auto start = std::chrono::steady_clock::now();
+        for (int message = 0; message < messages; ++message) {
+            request_handler.handleRequest(request);
+        }
+        const auto rate = messages / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        BOOST_TEST_MESSAGE(command << " (" << channels << " channels): " << rate << " requests/s");
+    }
+}
@@ -0,0 +1,46 @@
+//
+// Created by Benedikt on 17.10.2026.
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <atmo/devices.hpp>
+#include <atmo/mode.hpp>
+#include <atmo/virtual_devices.hpp>
+#include "../atmodevice/test_support.hpp"
+
+/**
+ * Helpers shared by the analyzer tests, in addition to the helpers of the device tests.
+ */
+namespace atmo::test {
+
+    /**
+     * Create mode callbacks that only support the control mode.
+     *
+     * @return the mode callbacks
+     */
+    inline ModeCallbacks controlModeCallbacks() {
+        return ModeCallbacks{
+                []() { return std::vector<Mode>{Mode::Control}; },
+                []() { return Mode::Control; },
+                [](Mode) {}};
+    }
+
+    /**
+     * Create a device manager with memory devices.
+     *
+     * @param count the number of devices
+     * @param channels the number of channels per device
+     * @return the device manager
+     */
+    inline Devices createDevices(std::size_t count, std::size_t channels) {
+        std::vector<Device> devices{};
+        for (std::size_t device = 0; device < count; ++device) {
+            devices.push_back(Device{"memory", std::make_unique<MemoryDevice>(channels, 1)});
+        }
+        return Devices{std::move(devices)};
+    }
+
+}
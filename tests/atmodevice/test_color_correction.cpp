@@ -0,0 +1,198 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+#include <atmo/color_correction.hpp>
+#include <atmo/device.hpp>
+
+using namespace atmo;
+using namespace std::chrono_literals;
+
+namespace {
+
+    class RecordingDevice : public BaseAtmoDevice {
+    public:
+        explicit RecordingDevice(std::size_t channels) :
+                BaseAtmoDevice{channels},
+                written{},
+                updates{0} {}
+
+        std::vector<Color> written;
+        int updates;
+
+        void reset() override {}
+
+    protected:
+        void update(gsl::span<const Color> channels) override {
+            written.assign(std::begin(channels), std::end(channels));
+            ++updates;
+        }
+    };
+
+    /**
+     * An AtmoDevice whose second update fails.
+     */
+    class FailingOnceDevice : public BaseAtmoDevice {
+    public:
+        FailingOnceDevice() :
+                BaseAtmoDevice{1},
+                writes{0},
+                m_attempts{0} {}
+
+        int writes;
+
+        void reset() override {}
+
+    protected:
+        void update(gsl::span<const Color>) override {
+            if (++m_attempts == 2) {
+                throw std::runtime_error{"Device failure"};
+            }
+            ++writes;
+        }
+
+    private:
+        int m_attempts;
+    };
+
+}
+
+BOOST_AUTO_TEST_CASE(color_correction_defaults_to_identity) {
+    const ColorCorrectionTable table{};
+    BOOST_TEST(table.identity());
+    for (int value = 0; value < 256; ++value) {
+        const auto component = static_cast<std::uint8_t>(value);
+        BOOST_TEST(table(Color{component, component, component}).green == component);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(color_correction_applies_gamma_gain_and_threshold) {
+    ColorCorrection color_correction{};
+    color_correction.gamma = 2.0;
+    color_correction.brightness = 0.5;
+    color_correction.blue = 0.5;
+    color_correction.min_threshold = 10;
+    const ColorCorrectionTable table{color_correction};
+    BOOST_TEST(!table.identity());
+
+    const auto white = table(Color{255, 255, 255});
+    BOOST_TEST(white.red == 128);
+    BOOST_TEST(white.green == 128);
+    BOOST_TEST(white.blue == 64);
+
+    // 128 -> (128 / 255)^2 * 0.5 * 255 = 32.1, 32 -> 2.0 is below the threshold.
+    const auto gray = table(Color{128, 128, 32});
+    BOOST_TEST(gray.red == 32);
+    BOOST_TEST(gray.blue == 0);
+}
+
+BOOST_AUTO_TEST_CASE(color_correction_rejects_illegal_parameters) {
+    BOOST_CHECK_THROW(ColorCorrectionTable{ColorCorrection{0.0}}, std::runtime_error);
+    BOOST_CHECK_THROW((ColorCorrectionTable{ColorCorrection{1.0, 1.5}}), std::runtime_error);
+    BOOST_CHECK_THROW((ColorCorrectionTable{ColorCorrection{1.0, 1.0, -0.1}}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(base_device_writes_corrected_colors) {
+    RecordingDevice device{2};
+    ColorCorrection color_correction{};
+    color_correction.brightness = 0.5;
+    device.setColorCorrection(color_correction);
+    device.setChannels(std::vector<Color>{{255, 100, 0}, {2, 2, 2}});
+    BOOST_REQUIRE(device.written.size() == 2);
+    BOOST_TEST(device.written[0].red == 128);
+    BOOST_TEST(device.written[0].green == 50);
+    BOOST_TEST(device.written[1].red == 1);
+    BOOST_TEST(device.getChannel(0).red == 255);
+}
+
+BOOST_AUTO_TEST_CASE(base_device_skips_unchanged_colors) {
+    RecordingDevice device{2};
+    device.setUpdatePolicy(UpdatePolicy{true, 2, 0ms});
+    device.setChannels(std::vector<Color>{{10, 10, 10}, {20, 20, 20}});
+    BOOST_TEST(device.updates == 1);
+
+    // Changes within the tolerance are not written, but accumulated changes are.
+    device.setChannels(std::vector<Color>{{10, 10, 10}, {20, 20, 20}});
+    device.setChannels(std::vector<Color>{{12, 10, 8}, {20, 20, 20}});
+    BOOST_TEST(device.updates == 1);
+    device.setChannels(std::vector<Color>{{13, 10, 10}, {20, 20, 20}});
+    BOOST_TEST(device.updates == 2);
+    device.setChannel(1, {20, 20, 20});
+    BOOST_TEST(device.updates == 2);
+
+    // Clearing is always written.
+    device.clear();
+    device.clear();
+    BOOST_TEST(device.updates == 4);
+
+    device.setUpdatePolicy(UpdatePolicy{false, 0, 0ms});
+    device.setChannels(std::vector<Color>{{0, 0, 0}, {0, 0, 0}});
+    BOOST_TEST(device.updates == 5);
+}
+
+BOOST_AUTO_TEST_CASE(base_device_writes_unchanged_colors_for_keep_alive) {
+    RecordingDevice device{1};
+    device.setUpdatePolicy(UpdatePolicy{true, 0, 50ms});
+    device.setChannels(std::vector<Color>{{1, 1, 1}});
+    device.setChannels(std::vector<Color>{{1, 1, 1}});
+    BOOST_TEST(device.updates == 1);
+    std::this_thread::sleep_for(60ms);
+    device.setChannels(std::vector<Color>{{1, 1, 1}});
+    BOOST_TEST(device.updates == 2);
+}
+
+BOOST_AUTO_TEST_CASE(base_device_rewrites_colors_after_failure) {
+    FailingOnceDevice device{};
+    device.setChannels(std::vector<Color>{{1, 1, 1}});
+    BOOST_CHECK_THROW(device.setChannels(std::vector<Color>{{2, 2, 2}}), std::runtime_error);
+    device.setChannels(std::vector<Color>{{2, 2, 2}});
+    BOOST_TEST(device.writes == 2);
+}
+
+BOOST_AUTO_TEST_CASE(base_device_sets_channel_colors_with_one_update) {
+    RecordingDevice device{4};
+    const std::vector<ChannelColor> channel_colors{{0, {1, 1, 1}}, {2, {2, 2, 2}}, {3, {3, 3, 3}}};
+    device.setChannelColors(channel_colors);
+    BOOST_TEST(device.updates == 1);
+    BOOST_TEST(device.getChannel(1).red == 0);
+    BOOST_TEST(device.getChannel(2).red == 2);
+
+    // Invalid channels are rejected without changing any channel.
+    const std::vector<ChannelColor> invalid{{0, {5, 5, 5}}, {4, {5, 5, 5}}};
+    BOOST_CHECK_THROW(device.setChannelColors(invalid), std::runtime_error);
+    BOOST_TEST(device.getChannel(0).red == 1);
+    BOOST_TEST(device.updates == 1);
+}
+
+BOOST_AUTO_TEST_CASE(color_correction_throughput) {
+    std::mt19937 random{7};
+    std::uniform_int_distribution<int> distribution{0, 255};
+    std::vector<Color> colors(256);
+    for (auto& color : colors) {
+        color = Color{static_cast<std::uint8_t>(distribution(random)),
+                      static_cast<std::uint8_t>(distribution(random)),
+                      static_cast<std::uint8_t>(distribution(random))};
+    }
+    std::vector<Color> corrected(colors.size());
+    const ColorCorrectionTable table{ColorCorrection{2.2, 0.8, 1.0, 0.9, 0.8, 4}};
+
+    constexpr int frames{100000};
+    unsigned int check{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        table.apply(colors, corrected);
+        check += corrected[frame % corrected.size()].red;
+    }
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    const auto frame_time = duration.count() / frames;
+    BOOST_TEST_MESSAGE("Color correction of 256 channels: " << frame_time * 1e9 << " ns per frame"
+                                                            << " (checksum " << check << ")");
+    // A frame at 60 fps takes 16.7 ms, the correction has to stay far below.
+    BOOST_TEST(frame_time < 100e-6);
+}
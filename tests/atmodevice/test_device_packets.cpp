@@ -0,0 +1,230 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#define BOOST_TEST_MODULE test_device
+
+#include <boost/test/included/unit_test.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+#include <random>
+#include <atmo/device_packets.hpp>
+#include <atmo/spi_devices.hpp>
+#include <atmo/spi_strip_packets.hpp>
+
+using namespace atmo;
+
+namespace {
+
+    std::vector<Color> randomColors(std::size_t count) {
+        std::mt19937 random{7};
+        std::uniform_int_distribution<int> distribution{0, 255};
+        std::vector<Color> colors(count);
+        for (auto& color : colors) {
+            color = Color{static_cast<std::uint8_t>(distribution(random)),
+                          static_cast<std::uint8_t>(distribution(random)),
+                          static_cast<std::uint8_t>(distribution(random))};
+        }
+        return colors;
+    }
+
+    /**
+     * The DotStar packet as it has been encoded before the brightness lookup table.
+     */
+    std::vector<unsigned char> referenceDotStarPacket(gsl::span<const Color> channels) {
+        std::vector<unsigned char> buffer{0x0, 0x0, 0x0, 0x0};
+        for (const auto color : channels) {
+            const auto intensity = (color.red + color.green + color.blue) / (3.0f * 255.0f);
+            buffer.push_back(0b11100000 | static_cast<unsigned char>(intensity * 31));
+            buffer.push_back(color.blue);
+            buffer.push_back(color.green);
+            buffer.push_back(color.red);
+        }
+        return buffer;
+    }
+
+    const std::vector<Color> TWO_LEDS{{255, 128, 0}, {4, 2, 1}};
+
+    void checkEqual(gsl::span<const unsigned char> actual, const std::vector<unsigned char>& expected) {
+        BOOST_TEST(std::vector<unsigned char>(std::begin(actual), std::end(actual)) == expected,
+                   boost::test_tools::per_element());
+    }
+
+    template<class Packet>
+    void measureThroughput(const std::string& name, Packet& packet, gsl::span<const Color> channels) {
+        constexpr int packets{100000};
+        unsigned int check{0};
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < packets; ++i) {
+            check += packet.encode(channels)[4];
+        }
+        const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+        BOOST_TEST_MESSAGE(name << ": " << packets / duration.count() << " packets/s, "
+                                << packets * channels.size() / duration.count() / 1e6 << " M channels/s"
+                                << " (checksum " << check << ")");
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(atmolight_packet) {
+    AtmoLightPacket packet{};
+    const std::vector<Color> channels{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}};
+    checkEqual(packet.encode(channels),
+               {0xFF, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    BOOST_CHECK_THROW(packet.encode(std::vector<Color>(5)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(karatelight_packet) {
+    KarateLightPacket packet{};
+    const auto channels = randomColors(KarateLightPacket::CHANNELS);
+    std::vector<unsigned char> expected{0xAA, 0x12, 0x00, 0x30};
+    for (const auto color : channels) {
+        expected.insert(std::end(expected), {color.green, color.blue, color.red});
+    }
+    unsigned char checksum{0};
+    for (const auto byte : expected) {
+        checksum ^= byte;
+    }
+    expected[2] = checksum;
+
+    // The checksum of the previous packet must not affect the next one.
+    checkEqual(packet.encode(channels), expected);
+    checkEqual(packet.encode(channels), expected);
+}
+
+BOOST_AUTO_TEST_CASE(dotstar_packet_matches_float_brightness) {
+    std::vector<Color> channels{};
+    for (int value = 0; value < 256; ++value) {
+        const auto component = static_cast<std::uint8_t>(value);
+        channels.emplace_back(component, component, component);
+        channels.emplace_back(component, 0, 0);
+        channels.emplace_back(component, 255, static_cast<std::uint8_t>(255 - value));
+    }
+    DotStarPacket packet{channels.size()};
+    const auto encoded = packet.encode(channels);
+    auto expected = referenceDotStarPacket(channels);
+    // 768 LEDs need 384 additional clock pulses.
+    expected.insert(std::end(expected), 48, 0xFF);
+    checkEqual(encoded, expected);
+}
+
+BOOST_AUTO_TEST_CASE(apa102_packets) {
+    SPIStripPacket<APA102Protocol<GlobalBrightness::Full>> full{2};
+    checkEqual(full.encode(TWO_LEDS),
+               {0, 0, 0, 0, 0xFF, 0, 128, 255, 0xFF, 1, 2, 4, 0xFF, 0xFF, 0xFF, 0xFF});
+    SPIStripPacket<APA102Protocol<GlobalBrightness::Color>> color{2};
+    checkEqual(color.encode(TWO_LEDS),
+               {0, 0, 0, 0, 0xEF, 0, 128, 255, 0xE0, 1, 2, 4, 0xFF, 0xFF, 0xFF, 0xFF});
+    SPIStripPacket<APA102Protocol<GlobalBrightness::HighDepth>> high_depth{2};
+    checkEqual(high_depth.encode(TWO_LEDS),
+               {0, 0, 0, 0, 0xFF, 0, 128, 255, 0xE1, 31, 62, 124, 0xFF, 0xFF, 0xFF, 0xFF});
+    BOOST_CHECK_THROW(full.encode(std::vector<Color>(3)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(apa102_high_depth_keeps_intensity) {
+    SPIStripPacket<APA102Protocol<GlobalBrightness::HighDepth>> packet{1};
+    for (const auto color : randomColors(10000)) {
+        const auto frame = packet.encode(gsl::span<const Color>{&color, 1}).subspan(4, 4);
+        const int brightness = frame[0] & 0x1F;
+        for (const auto& [component, value] : {std::pair{frame[3], color.red},
+                                              std::pair{frame[2], color.green},
+                                              std::pair{frame[1], color.blue}}) {
+            // The intensity brightness / 31 * component deviates by at most half a step of the component.
+            BOOST_TEST(2 * std::abs(brightness * component - 31 * value) <= brightness);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sk9822_packet) {
+    SPIStripPacket<SK9822Protocol<GlobalBrightness::HighDepth>> packet{2};
+    checkEqual(packet.encode(TWO_LEDS),
+               {0, 0, 0, 0, 0xFF, 0, 128, 255, 0xE1, 31, 62, 124, 0, 0, 0, 0, 0});
+}
+
+BOOST_AUTO_TEST_CASE(ws2801_packet) {
+    SPIStripPacket<WS2801Protocol> packet{2};
+    checkEqual(packet.encode(TWO_LEDS), {255, 128, 0, 4, 2, 1});
+}
+
+BOOST_AUTO_TEST_CASE(lpd8806_packet) {
+    SPIStripPacket<LPD8806Protocol> packet{2};
+    checkEqual(packet.encode(TWO_LEDS), {0xC0, 0xFF, 0x80, 0x81, 0x82, 0x80, 0x00});
+}
+
+BOOST_AUTO_TEST_CASE(p9813_packet) {
+    SPIStripPacket<P9813Protocol> packet{2};
+    checkEqual(packet.encode(TWO_LEDS), {0, 0, 0, 0, 0xF4, 0, 128, 255, 0xFF, 1, 2, 4, 0, 0, 0, 0});
+}
+
+namespace {
+
+    SPIConfig spiConfig(std::size_t max_transfer_size, std::size_t max_message_size) {
+        SPIConfig config{};
+        config.max_transfer_size = max_transfer_size;
+        config.max_message_size = max_message_size;
+        return config;
+    }
+
+    void checkSplit(const SPITransfers& transfers,
+                    const std::vector<std::pair<std::size_t, std::size_t>>& segments,
+                    const std::vector<std::size_t>& messages) {
+        BOOST_REQUIRE_EQUAL(transfers.segments.size(), segments.size());
+        for (std::size_t segment = 0; segment < segments.size(); ++segment) {
+            BOOST_TEST(transfers.segments[segment].offset == segments[segment].first);
+            BOOST_TEST(transfers.segments[segment].length == segments[segment].second);
+        }
+        BOOST_TEST(transfers.messages == messages, boost::test_tools::per_element());
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(spi_split_of_exact_multiples) {
+    checkSplit(splitSPITransfers(8192, spiConfig(4096, 4096), 8), {{0, 4096}, {4096, 4096}}, {1, 1});
+    checkSplit(splitSPITransfers(4096, spiConfig(1024, 2048), 8),
+               {{0, 1024}, {1024, 1024}, {2048, 1024}, {3072, 1024}}, {2, 2});
+    checkSplit(splitSPITransfers(0, spiConfig(1024, 2048), 8), {}, {});
+}
+
+BOOST_AUTO_TEST_CASE(spi_split_limits_segments_to_message_size) {
+    // Segments are never larger than a message.
+    checkSplit(splitSPITransfers(7000, spiConfig(8192, 3000), 8), {{0, 3000}, {3000, 3000}, {6000, 1000}}, {1, 1, 1});
+    // The last segment of a message is shortened to fill the message.
+    checkSplit(splitSPITransfers(5000, spiConfig(3000, 4096), 8), {{0, 3000}, {3000, 1096}, {4096, 904}}, {2, 1});
+}
+
+BOOST_AUTO_TEST_CASE(spi_split_limits_segments_per_message) {
+    checkSplit(splitSPITransfers(1000, spiConfig(100, 4096), 3),
+               {{0, 100}, {100, 100}, {200, 100}, {300, 100}, {400, 100},
+                {500, 100}, {600, 100}, {700, 100}, {800, 100}, {900, 100}},
+               {3, 3, 3, 1});
+}
+
+BOOST_AUTO_TEST_CASE(spi_split_rejects_empty_transfers) {
+    BOOST_CHECK_THROW(static_cast<void>(splitSPITransfers(100, spiConfig(0, 4096), 8)), std::runtime_error);
+    BOOST_CHECK_THROW(static_cast<void>(splitSPITransfers(100, spiConfig(4096, 0), 8)), std::runtime_error);
+    BOOST_CHECK_THROW(static_cast<void>(splitSPITransfers(100, spiConfig(4096, 4096), 0)), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(packet_encoding_throughput) {
+    AtmoLightPacket atmolight{};
+    KarateLightPacket karatelight{};
+    measureThroughput("AtmoLight", atmolight, randomColors(AtmoLightPacket::CHANNELS));
+    measureThroughput("KarateLight", karatelight, randomColors(KarateLightPacket::CHANNELS));
+
+    const auto leds = randomColors(600);
+    SPIStripPacket<APA102Protocol<GlobalBrightness::Full>> apa102_full{leds.size()};
+    SPIStripPacket<APA102Protocol<GlobalBrightness::Color>> apa102_color{leds.size()};
+    SPIStripPacket<APA102Protocol<GlobalBrightness::HighDepth>> apa102_high_depth{leds.size()};
+    SPIStripPacket<SK9822Protocol<GlobalBrightness::HighDepth>> sk9822{leds.size()};
+    SPIStripPacket<WS2801Protocol> ws2801{leds.size()};
+    SPIStripPacket<LPD8806Protocol> lpd8806{leds.size()};
+    SPIStripPacket<P9813Protocol> p9813{leds.size()};
+    measureThroughput("APA102 full (600 LEDs)", apa102_full, leds);
+    measureThroughput("APA102 color (600 LEDs)", apa102_color, leds);
+    measureThroughput("APA102 high depth (600 LEDs)", apa102_high_depth, leds);
+    measureThroughput("SK9822 high depth (600 LEDs)", sk9822, leds);
+    measureThroughput("WS2801 (600 LEDs)", ws2801, leds);
+    measureThroughput("LPD8806 (600 LEDs)", lpd8806, leds);
+    measureThroughput("P9813 (600 LEDs)", p9813, leds);
+}
@@ -0,0 +1,222 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atmo/network_devices.hpp>
+#include "test_support.hpp"
+
+using namespace atmo;
+using namespace atmo::test;
+using boost::asio::ip::udp;
+
+namespace {
+
+    /**
+     * Stand-in for a network receiver that listens on a random loopback port.
+     */
+    class Listener {
+    public:
+        Listener() :
+                m_io_context{},
+                m_socket{m_io_context, udp::endpoint{boost::asio::ip::address_v4::loopback(), 0}} {}
+
+        [[nodiscard]]
+        NetworkConfig config() const {
+            NetworkConfig config{};
+            config.address = "127.0.0.1";
+            config.port = m_socket.local_endpoint().port();
+            return config;
+        }
+
+        std::vector<unsigned char> receive() {
+            const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds{1};
+            while (m_socket.available() == 0) {
+                if (std::chrono::steady_clock::now() > timeout) {
+                    BOOST_FAIL("No packet received");
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+            std::vector<unsigned char> packet(m_socket.available());
+            packet.resize(m_socket.receive(boost::asio::buffer(packet)));
+            return packet;
+        }
+
+        void skip(std::size_t packets) {
+            for (std::size_t packet = 0; packet < packets; ++packet) {
+                receive();
+            }
+        }
+
+    private:
+        boost::asio::io_context m_io_context;
+        udp::socket m_socket;
+    };
+
+    std::uint16_t readUInt16(const std::vector<unsigned char>& packet, std::size_t position) {
+        return static_cast<std::uint16_t>((packet[position] << 8) | packet[position + 1]);
+    }
+
+    void checkPayload(const std::vector<unsigned char>& packet,
+                      std::size_t position,
+                      const std::vector<Color>& colors,
+                      std::size_t first,
+                      std::size_t count) {
+        BOOST_REQUIRE_GE(packet.size(), position + count * 3);
+        for (std::size_t channel = 0; channel < count; ++channel) {
+            const auto& color = colors[first + channel];
+            BOOST_TEST(packet[position + channel * 3] == color.red);
+            BOOST_TEST(packet[position + channel * 3 + 1] == color.green);
+            BOOST_TEST(packet[position + channel * 3 + 2] == color.blue);
+        }
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(ddp_splits_frames_and_pushes_last_packet) {
+    Listener listener{};
+    DDPDevice device{listener.config(), 500};
+    listener.skip(2);
+
+    const auto colors = testColors(500);
+    device.setChannels(colors);
+
+    const auto first = listener.receive();
+    BOOST_REQUIRE_EQUAL(first.size(), 10U + 480 * 3);
+    BOOST_TEST(first[0] == 0x40);
+    BOOST_TEST(first[1] == 2);
+    BOOST_TEST(first[2] == 0x0B);
+    BOOST_TEST(first[3] == 0x01);
+    BOOST_TEST(readUInt16(first, 4) == 0);
+    BOOST_TEST(readUInt16(first, 6) == 0);
+    BOOST_TEST(readUInt16(first, 8) == 480 * 3);
+    checkPayload(first, 10, colors, 0, 480);
+
+    const auto last = listener.receive();
+    BOOST_REQUIRE_EQUAL(last.size(), 10U + 20 * 3);
+    BOOST_TEST(last[0] == 0x41);
+    BOOST_TEST(last[1] == 2);
+    BOOST_TEST(readUInt16(last, 6) == 480 * 3);
+    BOOST_TEST(readUInt16(last, 8) == 20 * 3);
+    checkPayload(last, 10, colors, 480, 20);
+}
+
+BOOST_AUTO_TEST_CASE(ddp_sequence_wraps_to_one) {
+    Listener listener{};
+    DDPDevice device{listener.config(), 4};
+    device.setUpdatePolicy(UpdatePolicy{false, 0, std::chrono::milliseconds{0}});
+    listener.skip(1);
+
+    for (unsigned int frame = 2; frame <= 17; ++frame) {
+        device.setChannels(testColors(4));
+        BOOST_TEST(listener.receive()[1] == (frame - 1) % 15 + 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(e131_splits_universes_and_synchronizes) {
+    Listener listener{};
+    auto config = listener.config();
+    config.universe = 5;
+    config.sync = true;
+    E131Device device{config, 200};
+    listener.skip(3);
+
+    const auto colors = testColors(200);
+    device.setChannels(colors);
+
+    const std::string identifier{"ASC-E1.17"};
+    for (std::size_t universe = 0; universe < 2; ++universe) {
+        const auto slots = universe == 0 ? 510U : 90U;
+        const auto packet = listener.receive();
+        BOOST_REQUIRE_EQUAL(packet.size(), 126 + slots);
+        BOOST_TEST(readUInt16(packet, 0) == 0x0010);
+        BOOST_TEST(std::string(packet.begin() + 4, packet.begin() + 13) == identifier);
+        BOOST_TEST(readUInt16(packet, 16) == (0x7000 | (packet.size() - 16)));
+        BOOST_TEST(readUInt16(packet, 20) == 4);
+        BOOST_TEST(readUInt16(packet, 38) == (0x7000 | (packet.size() - 38)));
+        BOOST_TEST(readUInt16(packet, 42) == 2);
+        BOOST_TEST(std::string(packet.begin() + 44, packet.begin() + 53) == "atmolight");
+        BOOST_TEST(packet[108] == 100);
+        BOOST_TEST(readUInt16(packet, 109) == 5);
+        BOOST_TEST(packet[111] == 1);
+        BOOST_TEST(readUInt16(packet, 113) == 5 + universe);
+        BOOST_TEST(readUInt16(packet, 115) == (0x7000 | (packet.size() - 115)));
+        BOOST_TEST(packet[117] == 0x02);
+        BOOST_TEST(packet[118] == 0xA1);
+        BOOST_TEST(readUInt16(packet, 123) == slots + 1);
+        BOOST_TEST(packet[125] == 0);
+        checkPayload(packet, 126, colors, universe * 170, slots / 3);
+    }
+
+    const auto sync = listener.receive();
+    BOOST_REQUIRE_EQUAL(sync.size(), 49U);
+    BOOST_TEST(readUInt16(sync, 16) == (0x7000 | 33));
+    BOOST_TEST(readUInt16(sync, 20) == 8);
+    BOOST_TEST(readUInt16(sync, 38) == (0x7000 | 11));
+    BOOST_TEST(readUInt16(sync, 42) == 1);
+    BOOST_TEST(sync[44] == 1);
+    BOOST_TEST(readUInt16(sync, 45) == 5);
+}
+
+BOOST_AUTO_TEST_CASE(artnet_splits_universes_and_synchronizes) {
+    Listener listener{};
+    auto config = listener.config();
+    config.sync = true;
+    ArtNetDevice device{config, 171};
+    listener.skip(3);
+
+    const auto colors = testColors(171);
+    device.setChannels(colors);
+
+    const std::string identifier{"Art-Net"};
+    for (std::size_t universe = 0; universe < 2; ++universe) {
+        const auto length = universe == 0 ? 510U : 4U;
+        const auto packet = listener.receive();
+        BOOST_REQUIRE_EQUAL(packet.size(), 18 + length);
+        BOOST_TEST(std::string(packet.begin(), packet.begin() + 7) == identifier);
+        BOOST_TEST(packet[7] == 0);
+        BOOST_TEST(packet[8] == 0x00);
+        BOOST_TEST(packet[9] == 0x50);
+        BOOST_TEST(readUInt16(packet, 10) == 14);
+        BOOST_TEST(packet[12] == 2);
+        BOOST_TEST(packet[14] == universe);
+        BOOST_TEST(packet[15] == 0);
+        BOOST_TEST(readUInt16(packet, 16) == length);
+        checkPayload(packet, 18, colors, universe * 170, universe == 0 ? 170 : 1);
+    }
+    BOOST_TEST(listener.receive().size() == 14U);
+}
+
+BOOST_AUTO_TEST_CASE(e131_rejects_universes_out_of_range) {
+    NetworkConfig config{};
+    config.address = "127.0.0.1";
+    config.universe = 0;
+    BOOST_CHECK_THROW((E131Device{config, 10}), std::runtime_error);
+    config.universe = 63999;
+    BOOST_CHECK_THROW((E131Device{config, 171}), std::runtime_error);
+    BOOST_CHECK_NO_THROW((E131Device{config, 170}));
+    BOOST_CHECK_THROW((E131Device{config, 0}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(e131_rejects_sync_universes_out_of_range) {
+    NetworkConfig config{};
+    config.address = "127.0.0.1";
+    config.sync = true;
+    config.sync_universe = 0;
+    BOOST_CHECK_THROW((E131Device{config, 10}), std::runtime_error);
+    config.sync_universe = 64000;
+    BOOST_CHECK_THROW((E131Device{config, 10}), std::runtime_error);
+    config.sync_universe = 63999;
+    BOOST_CHECK_NO_THROW((E131Device{config, 10}));
+}
+
+BOOST_AUTO_TEST_CASE(artnet_rejects_universes_out_of_range) {
+    NetworkConfig config{};
+    config.address = "127.0.0.1";
+    config.universe = 0x7FFF;
+    BOOST_CHECK_THROW((ArtNetDevice{config, 171}), std::runtime_error);
+}
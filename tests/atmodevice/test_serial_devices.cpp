@@ -0,0 +1,164 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <boost/test/unit_test.hpp>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atmo/serial_devices.hpp>
+#include "test_support.hpp"
+
+using namespace atmo;
+using namespace atmo::test;
+
+namespace {
+
+    /**
+     * Stand-in for a serial device: the master side of a pseudo terminal, whose slave side is opened by the device.
+     */
+    class PseudoTerminal {
+    public:
+        PseudoTerminal() :
+                m_master{posix_openpt(O_RDWR | O_NOCTTY)} {
+            BOOST_REQUIRE(m_master >= 0);
+            BOOST_REQUIRE(grantpt(m_master) == 0);
+            BOOST_REQUIRE(unlockpt(m_master) == 0);
+        }
+
+        ~PseudoTerminal() {
+            close(m_master);
+        }
+
+        PseudoTerminal(const PseudoTerminal&) = delete;
+
+        PseudoTerminal& operator=(const PseudoTerminal&) = delete;
+
+        [[nodiscard]]
+        std::string slave() const {
+            return ptsname(m_master);
+        }
+
+        /**
+         * Wait until data is available without reading it.
+         */
+        bool waitForData() {
+            pollfd poll_fd{m_master, POLLIN, 0};
+            return poll(&poll_fd, 1, 1000) > 0;
+        }
+
+        std::vector<unsigned char> read(std::size_t length) {
+            std::vector<unsigned char> data(length);
+            std::size_t position{0};
+            while (position < length) {
+                pollfd poll_fd{m_master, POLLIN, 0};
+                BOOST_REQUIRE_MESSAGE(poll(&poll_fd, 1, 1000) > 0, "No data received");
+                const auto result = ::read(m_master, data.data() + position, length - position);
+                BOOST_REQUIRE(result > 0);
+                position += static_cast<std::size_t>(result);
+            }
+            return data;
+        }
+
+    private:
+        int m_master;
+    };
+
+    /**
+     * A serial device with frames that are much larger than the buffer of the pseudo terminal, so writes stay pending
+     * until the frames are read. Each frame consists of the red component of the first channel.
+     */
+    class LargeFrameDevice : public SerialPortAtmoDevice {
+    public:
+        static constexpr std::size_t FRAME_SIZE{1 << 20};
+
+        explicit LargeFrameDevice(const std::string& filename) :
+                SerialPortAtmoDevice{filename, 115200, SerialConfig{}, 1},
+                m_buffer(FRAME_SIZE) {}
+
+    protected:
+        gsl::span<const unsigned char> writeBuffer(gsl::span<const Color> channels) final {
+            std::fill(std::begin(m_buffer), std::end(m_buffer), channels[0].red);
+            return m_buffer;
+        }
+
+    private:
+        std::vector<unsigned char> m_buffer;
+    };
+
+}
+
+BOOST_AUTO_TEST_CASE(serial_device_writes_packets) {
+    PseudoTerminal terminal{};
+    SerialConfig config{};
+    config.baud_rate = 115200;
+    KarateLight device{terminal.slave(), config};
+
+    KarateLightPacket packet{};
+    std::vector<Color> colors(KarateLightPacket::CHANNELS);
+    const auto cleared = packet.encode(colors);
+    const auto clear_frame = terminal.read(static_cast<std::size_t>(cleared.size()));
+    BOOST_TEST(clear_frame == cleared, boost::test_tools::per_element());
+
+    colors[3] = Color{10, 20, 30};
+    device.setChannel(3, colors[3]);
+    const auto expected = packet.encode(colors);
+    const auto frame = terminal.read(static_cast<std::size_t>(expected.size()));
+    BOOST_TEST(frame == expected, boost::test_tools::per_element());
+
+    BOOST_TEST(waitFor([&device]() { return device.statistics().frames == 2; }));
+    BOOST_TEST(device.statistics().bytes == static_cast<std::uint64_t>(cleared.size() + expected.size()));
+    BOOST_TEST(device.statistics().replaced_frames == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(serial_device_writes_after_reset) {
+    PseudoTerminal terminal{};
+    SerialConfig config{};
+    config.baud_rate = 115200;
+    KarateLight device{terminal.slave(), config};
+
+    KarateLightPacket packet{};
+    std::vector<Color> colors(KarateLightPacket::CHANNELS);
+    const auto cleared = packet.encode(colors);
+    terminal.read(static_cast<std::size_t>(cleared.size()));
+
+    // The port is reopened by the I/O thread of the device.
+    device.reset();
+    BOOST_TEST(device.statistics().frames == 0U);
+    colors[0] = Color{40, 50, 60};
+    device.setChannel(0, colors[0]);
+    const auto expected = packet.encode(colors);
+    const auto frame = terminal.read(static_cast<std::size_t>(expected.size()));
+    BOOST_TEST(frame == expected, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(serial_device_replaces_queued_frames) {
+    PseudoTerminal terminal{};
+    LargeFrameDevice device{terminal.slave()};
+    device.setUpdatePolicy(UpdatePolicy{false, 0, std::chrono::milliseconds{0}});
+
+    // The first frame blocks the port, the second frame is queued and replaced by the third.
+    device.setChannel(0, Color{1, 0, 0});
+    BOOST_REQUIRE(terminal.waitForData());
+    device.setChannel(0, Color{2, 0, 0});
+    device.setChannel(0, Color{3, 0, 0});
+
+    const auto first = terminal.read(LargeFrameDevice::FRAME_SIZE);
+    BOOST_TEST(std::all_of(std::begin(first), std::end(first), [](unsigned char value) { return value == 1; }));
+    const auto second = terminal.read(LargeFrameDevice::FRAME_SIZE);
+    BOOST_TEST(std::all_of(std::begin(second), std::end(second), [](unsigned char value) { return value == 3; }));
+
+    BOOST_TEST(waitFor([&device]() { return device.statistics().frames == 2; }));
+    BOOST_TEST(device.statistics().replaced_frames == 1U);
+    BOOST_TEST(device.statistics().max_latency.count() > 0);
+}
+
+BOOST_AUTO_TEST_CASE(serial_device_reports_missing_port) {
+    BOOST_CHECK_THROW(AtmoLight{"/dev/atmolight-does-not-exist"}, std::exception);
+}
@@ -0,0 +1,54 @@
+//
+// Created by Benedikt on 17.10.2026.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <atmo/channel.hpp>
+
+/**
+ * Helpers shared by the device tests.
+ */
+namespace atmo::test {
+
+    /**
+     * Create distinct colors for the given number of channels.
+     *
+     * @param count the number of colors
+     * @param seed varies the colors, so consecutive frames can differ
+     * @return the colors
+     */
+    inline std::vector<Color> testColors(std::size_t count, std::uint8_t seed = 0) {
+        std::vector<Color> colors(count);
+        for (std::size_t channel = 0; channel < count; ++channel) {
+            colors[channel] = Color{static_cast<std::uint8_t>(channel + seed),
+                                    static_cast<std::uint8_t>(channel * 3),
+                                    static_cast<std::uint8_t>(255 - channel - seed)};
+        }
+        return colors;
+    }
+
+    /**
+     * Wait until the predicate is satisfied by another thread.
+     *
+     * @param predicate the condition to wait for
+     * @param timeout the maximum time to wait
+     * @return the final result of the predicate
+     */
+    template<class Predicate>
+    bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::seconds{2}) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return predicate();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,143 @@
+//
+// Created by Benedikt on 16.10.2026.
+//
+
+#include <boost/test/unit_test.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <fmt/format.h>
+#include <atmo/virtual_devices.hpp>
+
+using namespace atmo;
+
+namespace {
+
+    std::string temporaryFilename(const std::string& name) {
+        return fmt::format("/tmp/atmolight-test-{}-{}", getpid(), name);
+    }
+
+    std::vector<unsigned char> readFile(const std::string& filename) {
+        std::ifstream file{filename, std::ios::binary};
+        return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(memory_device_records_recent_frames) {
+    MemoryDevice device{2, 3};
+    device.setUpdatePolicy(UpdatePolicy{false, 0, std::chrono::milliseconds{0}});
+    BOOST_TEST(device.recordedFrames().empty());
+
+    for (std::uint8_t frame = 1; frame <= 5; ++frame) {
+        device.setChannel(0, Color{frame, 0, 0});
+    }
+
+    const auto frames = device.recordedFrames();
+    BOOST_REQUIRE_EQUAL(frames.size(), 3U);
+    for (std::size_t frame = 0; frame < frames.size(); ++frame) {
+        BOOST_TEST(frames[frame].size() == 2U);
+        BOOST_TEST(frames[frame][0].red == frame + 3);
+    }
+    BOOST_TEST(device.frames() == 5U);
+}
+
+BOOST_AUTO_TEST_CASE(virtual_device_simulates_latency) {
+    SimulationConfig simulation{};
+    simulation.write_latency = std::chrono::milliseconds{20};
+    NullDevice device{4, simulation};
+
+    const auto start = std::chrono::steady_clock::now();
+    device.clear();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    BOOST_TEST((elapsed >= simulation.write_latency));
+    BOOST_TEST(device.frames() == 1U);
+}
+
+BOOST_AUTO_TEST_CASE(virtual_device_injects_repeatable_failures) {
+    SimulationConfig simulation{};
+    simulation.failure_rate = 0.5;
+
+    const auto failures = [&simulation]() {
+        NullDevice device{1, simulation};
+        std::vector<bool> failed{};
+        for (int frame = 0; frame < 100; ++frame) {
+            try {
+                device.clear();
+                failed.push_back(false);
+            } catch (const std::runtime_error&) {
+                failed.push_back(true);
+            }
+        }
+        BOOST_TEST(device.frames() + device.failures() == 100U);
+        return failed;
+    };
+
+    const auto first = failures();
+    const auto failed = std::count(std::begin(first), std::end(first), true);
+    BOOST_TEST(failed > 20);
+    BOOST_TEST(failed < 80);
+    BOOST_TEST(first == failures(), boost::test_tools::per_element());
+
+    simulation.failure_rate = 2.0;
+    BOOST_CHECK_THROW(NullDevice(1, simulation), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(file_device_writes_rgb_frames) {
+    const auto filename = temporaryFilename("file");
+    {
+        FileDevice device{filename, 2, FileType::Regular};
+        device.setChannels(std::vector<Color>{{1, 2, 3}, {4, 5, 6}});
+        device.setChannel(1, Color{7, 8, 9});
+    }
+    const std::vector<unsigned char> expected{1, 2, 3, 4, 5, 6, 1, 2, 3, 7, 8, 9};
+    BOOST_TEST(readFile(filename) == expected, boost::test_tools::per_element());
+
+    {
+        // Creating the device truncates the file, resetting it appends the following frames.
+        FileDevice device{filename, 1, FileType::Regular};
+        device.setChannel(0, Color{1, 1, 1});
+        device.reset();
+        BOOST_TEST(device.resets() == 1U);
+        device.setChannel(0, Color{2, 2, 2});
+    }
+    const std::vector<unsigned char> appended{1, 1, 1, 2, 2, 2};
+    BOOST_TEST(readFile(filename) == appended, boost::test_tools::per_element());
+    std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(fifo_device_drops_frames_without_reader) {
+    const auto filename = temporaryFilename("fifo");
+    FileDevice device{filename, 1000, FileType::Fifo};
+    device.setUpdatePolicy(UpdatePolicy{false, 0, std::chrono::milliseconds{0}});
+
+    const auto reader = open(filename.c_str(), O_RDONLY | O_NONBLOCK);
+    BOOST_REQUIRE(reader >= 0);
+
+    // The pipe holds 64KiB by default, so some of the 3000 byte frames have to be dropped.
+    for (int frame = 0; frame < 100; ++frame) {
+        device.setChannel(0, Color{static_cast<std::uint8_t>(frame), 0, 0});
+    }
+    const auto dropped = device.droppedFrames();
+    BOOST_TEST(dropped > 0U);
+    BOOST_TEST(dropped < 100U);
+
+    // Complete frames are written, so the reader stays in sync.
+    std::vector<unsigned char> frame(3000);
+    std::uint64_t written{0};
+    while (read(reader, frame.data(), frame.size()) == static_cast<ssize_t>(frame.size())) {
+        BOOST_TEST(frame[0] == written);
+        ++written;
+    }
+    BOOST_TEST(written > 0U);
+    BOOST_TEST(written == 100U - dropped);
+
+    close(reader);
+    std::remove(filename.c_str());
+}